@@ -0,0 +1,196 @@
+/*
+  bench.c
+  Cycle counts of the LCD primitives, run under simavr ("make bench").
+
+  The firmware is built for the atmega1284p, the closest part simavr
+  models (same avr51 core as the at90usb1286, no external memory bus).
+  The LCD command/data registers are moved to two bytes of internal
+  RAM, see the bench rules in the Makefile. An internal store is one
+  cycle cheaper than a store to the XMEM bus, so on the board every
+  bus write (two per pixel) costs one cycle more than reported here.
+
+  Cycles are counted with Timer1 at clk/1, the fixed cost of reading
+  the counter is measured first and taken off every result.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#include "avr_mcu_section.h"
+#include "lcd.h"
+#include "render.h"
+//Only some of the sprites are drawn here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-const-variable"
+#include "sprites.h"
+#pragma GCC diagnostic pop
+
+AVR_MCU(F_CPU, "atmega1284p");
+//Everything written to GPIOR0 is printed by simavr, line by line.
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+#define REPEAT      8
+
+//Image primitives read this and whatever follows it in flash,
+//the contents do not matter for timing.
+const uint16_t bench_image[26*16] PROGMEM = {0};
+
+typedef struct {
+    const char *name;
+    uint16_t width, height;
+} bench_size;
+
+const bench_size sizes[] = {
+    {"laser",   2,   5},
+    {"house",   2,   2},
+    {"monster", 26,  16},
+    {"screen",  320, 240},
+};
+#define SIZES   (sizeof(sizes) / sizeof(sizes[0]))
+
+volatile uint16_t overflows;
+uint32_t overhead;
+
+ISR(TIMER1_OVF_vect) {
+    overflows++;
+}
+
+static int console_putchar(char c, FILE *stream) {
+    (void)stream;
+    GPIOR0 = c;
+    return 0;
+}
+
+static FILE console = FDEV_SETUP_STREAM(console_putchar, NULL, _FDEV_SETUP_WRITE);
+
+static uint32_t now(void) {
+    uint16_t lo, hi;
+    cli();
+    lo = TCNT1;
+    hi = overflows;
+    //Overflow pending but not yet counted
+    if((TIFR1 & _BV(TOV1)) && lo < 0x8000)
+        hi++;
+    sei();
+    return ((uint32_t)hi << 16) | lo;
+}
+
+//Print cycles per call and per pixel (one decimal).
+static void report(const char *prim, const char *size, uint16_t w, uint16_t h,
+                   uint32_t total, uint8_t calls) {
+    uint32_t per_call = total / calls;
+    uint32_t per_px10 = per_call * 10 / ((uint32_t)w * h);
+    printf("%-20s %-8s %3ux%-3u %9lu %6lu.%lu\n", prim, size, w, h,
+           per_call, per_px10 / 10, per_px10 % 10);
+}
+
+static void bench_fill_rectangle_c(const bench_size *s) {
+    uint8_t i;
+    uint32_t t = now();
+    for(i = 0; i < REPEAT; i++)
+        fill_rectangle_c(0, 0, s->width, s->height, WHITE);
+    t = now() - t - overhead;
+    report("fill_rectangle_c", s->name, s->width, s->height, t, REPEAT);
+}
+
+static void bench_fill_image_pgm(const bench_size *s) {
+    uint8_t i;
+    uint32_t t = now();
+    for(i = 0; i < REPEAT; i++)
+        fill_image_pgm(0, 0, s->width, s->height, (uint16_t *)bench_image);
+    t = now() - t - overhead;
+    report("fill_image_pgm", s->name, s->width, s->height, t, REPEAT);
+}
+
+//The doubled blitter draws even widths only.
+static void bench_fill_image_pgm_2b(const bench_size *s) {
+    uint8_t i;
+    uint16_t w = (s->width + 1) & ~1;
+    uint32_t t = now();
+    for(i = 0; i < REPEAT; i++)
+        fill_image_pgm_2b(0, 0, w, s->height, (uint16_t *)bench_image);
+    t = now() - t - overhead;
+    report("fill_image_pgm_2b", s->name, w, s->height, t, REPEAT);
+}
+
+static void bench_display_char_col(void) {
+    uint8_t i;
+    uint32_t t;
+    display.x = display.y = 0;
+    t = now();
+    for(i = 0; i < REPEAT; i++)
+        display_char_col('8', WHITE, BLACK);
+    t = now() - t - overhead;
+    report("display_char_col", "char", 6, 8, t, REPEAT);
+}
+
+static void bench_display_string(void) {
+    uint8_t i;
+    uint32_t t = now();
+    for(i = 0; i < REPEAT; i++)
+        display_string_xy("12345", 0, 0);
+    t = now() - t - overhead;
+    report("display_string_xy", "score", 30, 8, t, REPEAT);
+}
+
+//A lockstep step of the full formation (5x5, two rows of each kind),
+//the worst the events job draws, against a frame's budget.
+const uint16_t bench_monster_pal[2] PROGMEM = {0x0000, 0xFFFF};
+
+static void bench_formation_step(void) {
+    uint8_t x, y;
+    const uint8_t *deltas[3] = {monster_delta_1AB_r, monster_delta_2AB_r, monster_delta_3AB_r};
+    const uint8_t *data[3] = {monster_sprite_1B_idx, monster_sprite_2B_idx, monster_sprite_3B_idx};
+    uint32_t t = now();
+    for(x = 0; x < 5; x++)
+        for(y = 0; y < 5; y++)
+            fill_image_pgm_spans(10 + x * 36, 32 + y * 19, deltas[y >> 1],
+                                 data[y >> 1], bench_monster_pal);
+    t = now() - t - overhead;
+    printf("formation step %lu cycles, budget %lu: %s\n", t, RENDER_BUDGET,
+           t <= RENDER_BUDGET ? "fits" : "OVER");
+}
+
+static void bench_clear_screen(void) {
+    uint32_t t = now();
+    clear_screen();
+    t = now() - t - overhead;
+    report("clear_screen", "screen", 320, 240, t, 1);
+}
+
+int main(void) {
+    uint8_t s;
+    stdout = &console;
+
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    TIMSK1 = _BV(TOIE1);
+    sei();
+    overhead = now();
+    overhead = now() - overhead;
+
+    set_orientation(West);
+    display.foreground = WHITE;
+    display.background = BLACK;
+
+    printf("%-20s %-8s %-7s %9s %8s\n", "primitive", "case", "size",
+           "cyc/call", "cyc/px");
+    for(s = 0; s < SIZES; s++)
+        bench_fill_rectangle_c(&sizes[s]);
+    for(s = 0; s < SIZES; s++)
+        bench_fill_image_pgm(&sizes[s]);
+    for(s = 0; s < SIZES; s++)
+        bench_fill_image_pgm_2b(&sizes[s]);
+    bench_display_char_col();
+    bench_display_string();
+    bench_formation_step();
+    bench_clear_screen();
+
+    //simavr stops when the core sleeps with interrupts off
+    cli();
+    sleep_mode();
+    return 0;
+}
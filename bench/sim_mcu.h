@@ -0,0 +1,16 @@
+/*  at90usb1286 registers used by lcd.c that the simulated atmega1284p
+    does not have. They are mapped onto a spare general purpose register
+    so lcd.c builds unchanged; the benchmark never calls init_lcd().
+ */
+#ifndef SIM_MCU_H
+#define SIM_MCU_H
+
+#define XMCRA   GPIOR1
+#define XMCRB   GPIOR1
+#define SRE     7
+#define XMM2    2
+#define XMM1    1
+#define EICRB   GPIOR1
+#define ISC61   5
+
+#endif /* SIM_MCU_H */
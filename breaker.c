@@ -17,6 +17,7 @@
    Timer 3 (16-bit) to scan LaFortuna's buttons for input.
    Screen is drawn at approx. 30fps using the ILI9341 driver's
    interrupts.
+   The interrupts only post tasks, main() runs them (sched.c).
    
    Author: Giacomo Meanti
    Code from other sources:
@@ -32,8 +33,11 @@
 #include <avr/eeprom.h>
 #include "lcd.h"
 #include "encoder.h"
-#include "image.h"
+#include "sprites.h"
 #include "keyboard.h"
+#include "render.h"
+#include "events.h"
+#include "sched.h"
 #include "svgrgb565.h"
 
 #define LED_INIT    DDRB  |=  _BV(PINB7)
@@ -41,13 +45,13 @@
 #define LED_OFF     PORTB &= ~_BV(PINB7) 
 
 //Cannon
-#define CANNON_WIDTH        26
-#define CANNON_HEIGHT       10
+#define CANNON_WIDTH        27
+#define CANNON_HEIGHT       11
 #define CANNON_SPEED        5
 
 //Lasers
-#define LASER_WIDTH         1
-#define LASER_HEIGHT        4
+#define LASER_WIDTH         2
+#define LASER_HEIGHT        5
 #define CANNON_LASER_SPEED  2
 #define MONSTER_LASER_SPEED 1
 #define MAX_MONSTER_LASERS  5
@@ -61,10 +65,34 @@
 #define MONSTERS_X          5
 #define MONSTERS_Y          5
 #define MONSTER_SPEED       8
+#define MAX_EXPLOSIONS      4
+#define EXPLOSION_FRAMES    8
 //MONSTERS_X * (MONSTER_PADDING_X + MONSTER_WIDTH) = 6*(30+8) = 228 < LCDWIDTH
+//Offset of column x / row y in the formation, which moves as one
+#define CELL_X(x)           ((x) * (MONSTER_WIDTH + MONSTER_PADDING_X))
+#define CELL_Y(y)           ((y) * (MONSTER_HEIGHT + MONSTER_PADDING_Y))
+#define MONSTER_KIND(y)     ((y) >> 1)
+#ifdef STAGGERED_STEP
+//One monster steps at a time, in this order: bottom row first, as the
+//row above steps down into it. A sweep moves all of them once.
+#define STEP_ORDER(x, y)    ((MONSTERS_Y - 1 - (y)) * MONSTERS_X + (x))
+#define STEP_X(c)           ((c) % MONSTERS_X)
+#define STEP_Y(c)           (MONSTERS_Y - 1 - (c) / MONSTERS_X)
+#define STEP_CELLS          (MONSTERS_X * MONSTERS_Y)
+#else
+//A formation step draws column by column, bottom row first, as the row
+//above steps down into it: c-th monster drawn is at STEP_X, STEP_Y.
+#define STEP_X(c)           ((c) / MONSTERS_Y)
+#define STEP_Y(c)           (MONSTERS_Y - 1 - (c) % MONSTERS_Y)
+#define STEP_CELLS          (MONSTERS_X * MONSTERS_Y)
+#endif
 
 #define MONSTER_POINTS      50
+#ifdef STAGGERED_STEP
+#define DRAW_MONSTERS_TICK  2   //Per monster, a full formation takes 50
+#else
 #define DRAW_MONSTERS_TICK  50
+#endif
 
 //Astro
 #define ASTRO_WIDTH         32
@@ -79,12 +107,20 @@
 #define ASTRO_Y             16
 
 //Heart
-#define HEART_WIDTH         8
-#define HEART_HEIGHT        7
+#define HEART_WIDTH         9
+#define HEART_HEIGHT        8
+
+//HUD
+#define SCORE_X             250
+#define SCORE_Y             5
+#define SCORE_DIGITS        5
+#define HEARTS_X            280
+#define HEARTS_Y            5
+#define HEART_SPACING       13
 
 //House
-#define HOUSE_WIDTH         31
-#define HOUSE_HEIGHT        23
+#define HOUSE_WIDTH         30
+#define HOUSE_HEIGHT        22
 #define HOUSE_COUNT         4
 #define HOUSE_PADDING_X     50
 #define HOUSE_START_X       20
@@ -93,12 +129,37 @@
 #define LCDWIDTH            320
 #define LCDHEIGHT           240
 
+//Render events, pushed by in_game_movement() for draw_events()
+#define EV_FORMATION_STEP   0   //a, b: int8_t dx, dy
+#define EV_MONSTER_KILLED   1   //a: x * MONSTERS_Y + y
+#define EV_HOUSE_HIT        2   //a: house, b: y << 4 | x of its 2x2 block
+#define EV_MONSTER_STEP     3   //a: x * MONSTERS_Y + y, STAGGERED_STEP only
+#ifdef STAGGERED_STEP
+#define EVENTS_PER_TICK     9   //1 sweep, 1 step, 1 kill, 6 lasers hitting houses
+#else
+#define EVENTS_PER_TICK     8   //1 step, 1 kill, 6 lasers hitting houses
+#endif
+
+//Bus traffic categories, see lcd_stats_category()
+#define STATS_HUD           0
+#define STATS_MONSTERS      1
+#define STATS_LASERS        2
+#define STATS_HOUSES        3
+#define STATS_OTHER         4   //Cannon, astro, the overlay itself
+#define STATS_Y             205 //Overlay strip, between houses and cannon
+#define TICKS_PER_SECOND    161 //Timer 1: 1MHz / (OCR1A + 1)
+
+//Tasks, highest priority first
+#define TASK_INPUT          0   //Timer 3, every 2ms
+#define TASK_FRAME          1   //Tearing interrupt
+#define TASK_TICK           2   //Timer 1
+
 #define FALSE               0
 #define TRUE                1
 
 #define HOME_SCREEN_ITEMS   3
-#define TRIANGLE_WIDTH      3
-#define TRIANGLE_HEIGHT     6
+#define TRIANGLE_WIDTH      4
+#define TRIANGLE_HEIGHT     7
 #define HOME_SCREEN_X       100
 
 #define STATE_HOME          0
@@ -106,10 +167,18 @@
 #define STATE_HIGH_SCORES   2
 #define STATE_ABOUT         3
 #define STATE_NEW_HIGH_SCORE 4
+#define STATE_GAME_OVER     5
+#define STATE_GAME_WON      6
+
+//End of a life and of the game, in frames of the tearing interrupt
+#define BLINK_FRAMES        5   //75ms at 61Hz
+#define LIFE_LOST_BLINKS    14  //The cannon explodes, 2 sprites in turn
+#define GAME_WON_FRAMES     18  //300ms
 
 #define MAX_HIGH_SCORES     20
 #define EEPROM_VALIDITY_CANARY  0xABCD
 #define HIGH_SCORE_X        85
+#define HIGH_SCORE_SCROLL   16
 
 typedef struct {
     uint16_t x, y;
@@ -118,7 +187,27 @@ typedef struct {
 } sprite;
 //Every sprite is 6 bytes
 
-const sprite start_cannon = {(LCDWIDTH-CANNON_WIDTH)/2, LCDHEIGHT-CANNON_HEIGHT-1, 1, 0};
+//How the panel is driven in each game state: idle shows 8 colours,
+//partial mode only lights screen x first..last (none if first > last).
+typedef struct {
+    uint8_t idle;
+    uint16_t first, last;
+} display_policy;
+
+const display_policy display_policies[] = {
+    [STATE_HOME]           = {TRUE,  HIGH_SCORE_X - 10, HIGH_SCORE_X + 70},
+    [STATE_PLAY]           = {FALSE, 1, 0},
+    [STATE_HIGH_SCORES]    = {FALSE, 1, 0}, //Colours, and scrolls out
+    [STATE_ABOUT]          = {TRUE,  0, 279},
+    [STATE_NEW_HIGH_SCORE] = {FALSE, 1, 0},
+    [STATE_GAME_OVER]      = {FALSE, 1, 0},
+    [STATE_GAME_WON]       = {FALSE, 1, 0},
+};
+
+const uint8_t home_items_y[HOME_SCREEN_ITEMS] = {90, 115, 140};
+char * const home_items[HOME_SCREEN_ITEMS] = {"Play!", "High scores", "About"};
+
+const sprite start_cannon = {(LCDWIDTH-CANNON_WIDTH)/2, LCDHEIGHT-CANNON_HEIGHT, 1, 0};
 const uint8_t start_house_data[24] = {
     0xFF,0xFC,      //11111111111111111111111111110000    
     0xFF,0xFC,      //11111111111111111111111111110000    
@@ -134,8 +223,54 @@ const uint8_t start_house_data[24] = {
     0x00,0x00,      //00000000000000000000000000000000    
 };
 
-volatile sprite monsters[MONSTERS_X][MONSTERS_Y];
-volatile sprite last_monsters[MONSTERS_X][MONSTERS_Y];
+//Monster sprites by kind and animation frame.
+const uint8_t * const monster_sprites[3][2] PROGMEM = {
+    {monster_sprite_1A_idx, monster_sprite_1B_idx},
+    {monster_sprite_2A_idx, monster_sprite_2B_idx},
+    {monster_sprite_3A_idx, monster_sprite_3B_idx},
+};
+//Their opaque pixels, to draw and erase them over something else.
+const uint8_t * const monster_spans[3][2] PROGMEM = {
+    {monster_sprite_1A_spans, monster_sprite_1B_spans},
+    {monster_sprite_2A_spans, monster_sprite_2B_spans},
+    {monster_sprite_3A_spans, monster_sprite_3B_spans},
+};
+//Spans to repaint when a monster steps and flips animation frame,
+//by kind, frame on screen and move (right, left, right+down, left+down).
+#define MONSTER_MOVES       4
+#define MONSTER_MOVE(dx, dy) (((dx) > 0 ? 0 : 1) + ((dy) ? 2 : 0))
+const uint8_t * const monster_deltas[3][2][MONSTER_MOVES] PROGMEM = {
+    {{monster_delta_1AB_r, monster_delta_1AB_l, monster_delta_1AB_rd, monster_delta_1AB_ld},
+     {monster_delta_1BA_r, monster_delta_1BA_l, monster_delta_1BA_rd, monster_delta_1BA_ld}},
+    {{monster_delta_2AB_r, monster_delta_2AB_l, monster_delta_2AB_rd, monster_delta_2AB_ld},
+     {monster_delta_2BA_r, monster_delta_2BA_l, monster_delta_2BA_rd, monster_delta_2BA_ld}},
+    {{monster_delta_3AB_r, monster_delta_3AB_l, monster_delta_3AB_rd, monster_delta_3AB_ld},
+     {monster_delta_3BA_r, monster_delta_3BA_l, monster_delta_3BA_rd, monster_delta_3BA_ld}},
+};
+//Monster colours (background, foreground), one palette per row.
+const uint16_t monster_palettes[MONSTERS_Y][2] PROGMEM = {
+    {BLACK, VIOLET},
+    {BLACK, DEEP_SKY_BLUE},
+    {BLACK, CYAN},
+    {BLACK, YELLOW},
+    {BLACK, WHITE},
+};
+
+//The formation: monster x, y is at CELL_X(x) + left_o, CELL_Y(y) + top_o.
+//Alive monsters: bit y of each column (MONSTERS_Y <= 8), and the
+//lowest alive row of each column, the one that shoots (-1 if none).
+uint8_t monster_columns[MONSTERS_X];
+int8_t monster_shooters[MONSTERS_X];
+uint8_t monster_rows[MONSTERS_Y]; //Alive monsters in each row
+uint8_t monsters_alive;
+//Outermost columns and rows with monsters left, the bounds follow them
+uint8_t first_column, last_column, top_row, bottom_row;
+#ifdef STAGGERED_STEP
+//Next cell of the sweep (STEP_CELLS when done) and its step: the origin
+//has already moved, the monsters from the cursor on are one step behind.
+uint8_t step_cursor;
+int8_t sweep_x, sweep_y;
+#endif
 volatile sprite cannon_laser;
 volatile sprite last_cannon_laser;
 volatile sprite cannon;
@@ -144,11 +279,39 @@ volatile sprite astro;
 volatile sprite last_astro;
 sprite monster_lasers[MAX_MONSTER_LASERS];
 sprite last_monster_lasers[MAX_MONSTER_LASERS];
+//What the lasers hide on screen
+#define LASER_PIXELS        (LASER_WIDTH * LASER_HEIGHT)
+uint16_t monster_laser_pixels[MAX_MONSTER_LASERS][LASER_PIXELS];
+uint16_t cannon_laser_pixels[LASER_PIXELS];
+save_under monster_laser_under[MAX_MONSTER_LASERS];
+save_under cannon_laser_under = {{0, 0, 0, 0}, FALSE, cannon_laser_pixels};
 volatile sprite houses[HOUSE_COUNT];
-//total memory = (5 * 5 * 2 + 6 + 5 * 2 + 4) * 6B = 70 * 6B = 420B
+//total memory = (6 + 5 * 2 + 4) * 6B = 20 * 6B = 120B
 uint8_t house_data[HOUSE_COUNT][24];
-uint8_t old_house_data[HOUSE_COUNT][24];
-//total memory = 4 * 24 * 2 + 20 * 2 = 232B
+//total memory = 4 * 24 + 20 * 2 = 136B
+
+event_ring play_events;
+//The formation as drawn: monsters on screen (bit x * MONSTERS_Y + y),
+//their offset, and the explosions showing (alive: frames left).
+uint32_t monsters_drawn;
+uint8_t monsters_drawn_count;
+int16_t drawn_left_o, drawn_top_o;
+sprite explosions[MAX_EXPLOSIONS];
+#ifdef STAGGERED_STEP
+//Monsters drawn before this cell of the sweep have moved by its step
+//and show the other frame; the offset catches up at the next sweep.
+uint8_t drawn_cursor;
+int8_t drawn_step_x, drawn_step_y;
+#define drawn_stepped(x, y) (STEP_ORDER(x, y) < drawn_cursor)
+#else
+#define drawn_stepped(x, y) 0
+//A formation step drawn over several frames: begun, next in step order
+uint8_t step_begun, step_cell;
+#endif
+//What draw_events() may spend this frame, see events_fit()
+uint32_t events_budget, events_spent;
+uint8_t events_forced;
+//total memory = 32 * 3 + 2 + 4 + 1 + 4 + 4 * 6 = 131B
 
 uint16_t EEMEM eeprom_high_scores[MAX_HIGH_SCORES + 1];
 char EEMEM eeprom_high_score_names[MAX_HIGH_SCORES][MAX_STRING_SIZE + 1];
@@ -156,9 +319,13 @@ uint16_t high_scores[MAX_HIGH_SCORES] = {0,1};
 char high_score_names[MAX_HIGH_SCORES][MAX_STRING_SIZE + 1];
 //total memory = 20 * 2B + 20 * 11 = 260B
 
-uint16_t leftmost, rightmost, topmost, bottommost;
-volatile int16_t left_o, top_o;
-int16_t last_left_o, last_top_o;
+uint8_t monster_frame; //Animation frame of the monsters on screen
+//HUD as it is on screen: score digits (space padded) and hearts.
+char hud_score[SCORE_DIGITS + 1];
+uint8_t hud_lives;
+uint16_t leftmost, rightmost, topmost, bottommost; //Moved with the formation
+int16_t left_o, top_o; //Origin of the formation
+uint16_t shot_p = 62700; //Monsters shoot when rand() is above it
 volatile uint16_t score;
 volatile uint8_t lives;
 volatile uint8_t has_monsters;
@@ -172,26 +339,69 @@ volatile uint8_t game_state;
 
 //High score/ New high score stuff
 uint8_t is_drawn;
+#ifdef LCD_STATS
+volatile uint8_t stats_overlay;     //Toggled by a long press North
+uint8_t stats_shown;
+bus_stats frame_bus_stats[LCD_STATS_CATEGORIES];  //Of the last frame
+volatile uint8_t stats_frames, stats_fps;
+uint16_t stats_isr_us;              //Play frame task time
+#endif
+#ifdef DL_DEBUG
+window_stats frame_window_stats;    //Of the last frame
+#endif
+volatile uint16_t scroll_x;
 //total memory = 27B
 //TOTAL static = 942B
 
+void input_task(void);
+void frame_task(void);
+void tick_task(void);
 void reset_sprites(void);
-void draw_cannon(void);
-void draw_monsters(void);
-void draw_monster(volatile sprite *monster, uint8_t version);
+uint32_t draw_cannon(uint32_t left);
+uint32_t draw_events(uint32_t left);
+uint8_t draw_event(render_event *e);
+uint8_t events_fit(uint32_t cost);
+uint8_t step_monsters(int8_t dx, int8_t dy);
+#ifdef STAGGERED_STEP
+void step_monster(uint8_t i);
+#endif
+void explode_monster(uint8_t i);
+void end_explosions(uint8_t all);
+void draw_monster_step(volatile sprite *monster, uint8_t move, uint8_t row);
+void draw_monster_over(volatile sprite *monster, uint8_t version, uint8_t row);
+void erase_monster(volatile sprite *monster, uint8_t version);
 void draw_monster_lasers(void);
 void draw_lasers(void);
+void restore_lasers(void);
 void draw_about(void);
-void draw_score(void);
-void draw_lives(void);
-void draw_astro(void);
-void draw_houses(void);
-void life_lost_sequence(void);
+void hud_reset(void);
+void draw_hud(void);
+#ifdef DL_DEBUG
+void draw_dl_stats(void);
+#endif
+#ifdef LCD_STATS
+void draw_bus_stats(void);
+#endif
+uint32_t draw_astro(uint32_t left);
+uint32_t cannon_cost(void);
+uint32_t events_cost(void);
+uint32_t astro_cost(void);
+uint32_t spans_cost(const uint8_t *spans);
+uint32_t explosions_cost(uint8_t all);
+uint32_t monster_step_cost(uint8_t y, uint8_t move);
+uint32_t explode_cost(uint8_t i);
+uint32_t event_cost(render_event *e);
+void life_lost_frame(void);
+void game_won_frame(void);
+void game_over_movement(void);
 void in_game_movement(void);
 void home_screen_movement(void);
 void about_movement(void);
 void draw_home_screen(void);
+void draw_home_item(uint8_t i);
+void set_display_policy(uint8_t state);
 void draw_high_scores(void);
+void scroll_high_scores(void);
 void draw_new_high_score(void);
 void new_high_score_movement(void);
 void high_score_movement(void);
@@ -202,19 +412,61 @@ uint8_t is_high_score(uint16_t score);
 uint8_t intersect_pp(sprite s1, uint8_t w1, uint8_t h1,
                      sprite s2, uint8_t w2, uint8_t h2,
                      uint8_t *data, rectangle *result);
+uint8_t laser_hits_monster(uint8_t *hx, uint8_t *hy);
+void kill_monster(uint8_t x, uint8_t y);
+void monster_shoot(uint8_t x);
+#ifdef STAGGERED_STEP
+uint8_t skip_dead(uint8_t c);
+#endif
 static inline uint8_t intersect_sprite(sprite s1, uint8_t w1, uint8_t h1, 
                                        sprite s2, uint8_t w2, uint8_t h2);
 uint16_t rand_init(void);
 uint16_t rand(void);
 
+//What can wait for the next frame, highest priority first. Lasers are
+//always drawn: they come off before and go back after all of these.
+const render_job play_jobs[] = {
+    {cannon_cost, draw_cannon},
+    {events_cost, draw_events},
+    {astro_cost, draw_astro},
+};
+
+//Run from main() by sched_run(), posted by the interrupts below.
+task tasks[] = {
+    [TASK_INPUT] = {input_task, 0, 0},
+    [TASK_FRAME] = {frame_task, 0, 0},
+    [TASK_TICK]  = {tick_task, 0, 0},
+};
+
 // ISR to scan rotary encoder input.
 ISR(TIMER3_COMPA_vect) {
-    scan_switches();
-    scan_encoder();           
+    sched_post(&tasks[TASK_INPUT]);
 }
 
 // ISR for input handling & sprite movement.
 ISR(TIMER1_COMPA_vect) {
+    sched_post(&tasks[TASK_TICK]);
+}
+
+// ISR for drawing. Triggered by screen refresh (tearing interrupt)
+ISR(INT6_vect) {
+    sched_post(&tasks[TASK_FRAME]);
+}
+
+void input_task(void) {
+    scan_switches();
+    scan_encoder();
+}
+
+void tick_task(void) {
+#ifdef LCD_STATS
+    static uint8_t ticks;
+    if(++ticks == TICKS_PER_SECOND) {
+        ticks = 0;
+        stats_fps = stats_frames;
+        stats_frames = 0;
+    }
+#endif
     switch(game_state) {
         case STATE_HOME:
             home_screen_movement();
@@ -231,27 +483,68 @@ ISR(TIMER1_COMPA_vect) {
         case STATE_ABOUT:
             about_movement();
             break;
+        case STATE_GAME_OVER:
+            game_over_movement();
+            break;
     }
 }
 
-// ISR for drawing. Triggered by screen refresh (tearing interrupt)
-ISR(INT6_vect) {
+void frame_task(void) {
+    static uint8_t policy_state = 0xFF;
+#ifdef LCD_STATS
+    uint16_t start, end;
+    uint8_t i;
+#endif
+    if(policy_state != game_state) {
+        set_display_policy(game_state);
+        policy_state = game_state;
+    }
     switch(game_state) {
         case STATE_HOME:
             draw_home_screen();
             break;
         case STATE_PLAY:
-            draw_score();
+#ifdef DL_DEBUG
+            frame_window_stats = lcd_window_stats;
+            lcd_window_stats.sent = lcd_window_stats.saved = 0;
+#endif
+#ifdef LCD_STATS
+            start = TCNT1;
+            stats_frames++;
+            lcd_stats_reset();
+#endif
+            lcd_stats_category(STATS_HUD);
+            draw_hud();
             if(lost_life) {
-                life_lost_sequence();
+                life_lost_frame();
                 return;
             }
+            dl_begin();
+            //Lasers are saved over everything else, so they come off
+            //first and go back last.
+            lcd_stats_category(STATS_LASERS);
+            restore_lasers();
+            //The overlays show the last frame. Drawn once the lasers are
+            //off, they are saved under them like the rest of the screen.
+#ifdef LCD_STATS
+            lcd_stats_category(STATS_OTHER);
+            draw_bus_stats();
+#endif
+#ifdef DL_DEBUG
+            draw_dl_stats();
+#endif
+            render_frame();
+            lcd_stats_category(STATS_LASERS);
             draw_monster_lasers();
-            draw_monsters();
             draw_lasers();
-            draw_cannon();
-            draw_astro();
-            draw_houses();
+            dl_end();
+#ifdef LCD_STATS
+            end = TCNT1;
+            //Timer 1 may have wrapped at OCR1A once
+            stats_isr_us = end >= start ? end - start : end + OCR1A + 1 - start;
+            for(i = 0; i < LCD_STATS_CATEGORIES; i++)
+                frame_bus_stats[i] = lcd_bus_stats[i];
+#endif
             break;
         case STATE_HIGH_SCORES:
             draw_high_scores();
@@ -262,262 +555,564 @@ ISR(INT6_vect) {
         case STATE_ABOUT:
             draw_about();
             break;
+        case STATE_GAME_WON:
+            game_won_frame();
+            break;
     }
 }
 
-void draw_cannon(void) {
-    fill_rectangle_c(last_cannon.x, last_cannon.y,
-                   CANNON_WIDTH, CANNON_HEIGHT,
-                   display.background);
-    fill_image_pgm(cannon.x, cannon.y,
+//Only when it moved, clearing the strip it uncovers (last_cannon is
+//not alive when nothing is on screen).
+uint32_t draw_cannon(uint32_t left) {
+    uint32_t spent = cannon_cost();
+    uint16_t x, w;
+    (void)left;
+    if(!spent)
+        return 0;
+    lcd_stats_category(STATS_OTHER);
+    if(last_cannon.alive) {
+        if(cannon.x > last_cannon.x) {
+            x = last_cannon.x;
+            w = cannon.x - last_cannon.x;
+        } else {
+            x = cannon.x + CANNON_WIDTH;
+            w = last_cannon.x - cannon.x;
+        }
+        if(w > CANNON_WIDTH) {
+            x = last_cannon.x;
+            w = CANNON_WIDTH;
+        }
+        dl_fill_rectangle_c(x, last_cannon.y, w, CANNON_HEIGHT, display.background);
+    }
+    dl_fill_image_pgm_rle(cannon.x, cannon.y,
                    CANNON_WIDTH, CANNON_HEIGHT,
-                   cannon_sprite);
+                   cannon_sprite_rle);
     last_cannon = cannon;
+    return spent;
 }
 
-void draw_astro(void) {
+uint32_t draw_astro(uint32_t left) {
+    uint32_t spent = astro_cost();
+    (void)left;
+    lcd_stats_category(STATS_OTHER);
     if(astro.alive) {
         if(last_astro.x != astro.x && astro.alive <= 2) {
             //Clear
-            fill_rectangle_c(last_astro.x, astro.y,
+            dl_fill_rectangle_c(last_astro.x, astro.y,
                              astro.x - last_astro.x,
                              ASTRO_HEIGHT, display.background);
             if(astro.alive == 1) {
                 //Fill
-                fill_image_pgm_2b(astro.x, astro.y, ASTRO_WIDTH, ASTRO_HEIGHT, astro_sprite);
+                dl_fill_image_pgm_indexed_scaled(astro.x, astro.y, ASTRO_WIDTH, ASTRO_HEIGHT,
+                    astro_sprite_idx, astro_sprite_pal, 2, 2);
             }
         }
         if(astro.alive >= 2 && astro.alive <= 9) {
             if(astro.alive == 2) {
-                fill_image_pgm_2b(astro.x, astro.y,
-                    MONSTER_WIDTH, MONSTER_HEIGHT, monster_sprite_exp);
-                fill_rectangle_c(astro.x + MONSTER_WIDTH, astro.y, 
-                    ASTRO_WIDTH - MONSTER_WIDTH, ASTRO_HEIGHT, display.background);
+                dl_fill_spans(last_astro.x, last_astro.y,
+                    astro_sprite_spans, display.background);
+                dl_fill_image_pgm_spans(astro.x, astro.y,
+                    monster_sprite_exp_spans,
+                    monster_sprite_exp_idx, monster_sprite_exp_pal);
             }
             astro.alive++;
         } else if(astro.alive >= 10) {
-            fill_rectangle_c(astro.x, astro.y, MONSTER_WIDTH, MONSTER_HEIGHT, display.background);
+            dl_fill_spans(astro.x, astro.y, monster_sprite_exp_spans, display.background);
             astro.alive = FALSE;
         }
         last_astro = astro;
     } else if(last_astro.alive) {
-        fill_rectangle_c(last_astro.x, astro.y, ASTRO_WIDTH, ASTRO_HEIGHT, display.background);
+        dl_fill_rectangle_c(last_astro.x, astro.y, ASTRO_WIDTH, ASTRO_HEIGHT, display.background);
         last_astro = astro;
     }
+    return spent;
 }
 
-void draw_monsters(void) {
-    uint8_t x, y;
-    //Flag to indicate whether to use monster_sprite_1 or 2.
-    static uint8_t monster_drawing = 0;
-    uint8_t right = left_o > last_left_o;
-    uint8_t change_topmost = top_o - last_top_o;
-    uint8_t change_leftmost = right ? left_o - last_left_o
-                                    : last_left_o - left_o;
-    for(x = 0; x < MONSTERS_X; x++) {
-        for(y = 0; y < MONSTERS_Y; y++) {
-            if(monsters[x][y].alive) { //Draw sprite                        
-                //Vertical
-                if(change_topmost) {
-                    // Clear
-                    // This -1 does not make sense.
-                    fill_rectangle_c(last_monsters[x][y].x, last_monsters[x][y].y,
-                        MONSTER_WIDTH, change_topmost - 1, display.background);
-                    
-                }
-                if(change_leftmost && monsters[x][y].alive <= 2) {
-                    //Horizontal clear
-                    fill_rectangle_c(
-                        right ? last_monsters[x][y].x
-                              : monsters[x][y].x + MONSTER_WIDTH,
-                        monsters[x][y].y,
-                        change_leftmost,
-                        MONSTER_HEIGHT,
-                        display.background);
-                    //Horizontal draw
-                    if(monsters[x][y].alive == 1) {
-                        draw_monster(&monsters[x][y], monster_drawing);
-                    }
-                }
-                if(monsters[x][y].alive >= 2 && monsters[x][y].alive <= 9) { // Big explosion (4 frames)
-                    if(monsters[x][y].alive == 2) {
-                        fill_image_pgm_2b(monsters[x][y].x, monsters[x][y].y,
-                            MONSTER_WIDTH, MONSTER_HEIGHT, monster_sprite_exp);
-                    }
-                    monsters[x][y].alive++;
-                } else if(monsters[x][y].alive >= 10) { // Clear
-                    fill_rectangle_c(monsters[x][y].x, monsters[x][y].y,
-                        MONSTER_WIDTH, MONSTER_HEIGHT, display.background);
-                    monsters[x][y].alive = FALSE;
-                }
-                last_monsters[x][y] = monsters[x][y];
-            }
+//Where the monster at x, y of the formation is on screen.
+static inline sprite drawn_monster(uint8_t x, uint8_t y) {
+    sprite m;
+    m.x = CELL_X(x) + drawn_left_o;
+    m.y = CELL_Y(y) + drawn_top_o;
+    m.alive = 1;
+    m.kind = MONSTER_KIND(y);
+#ifdef STAGGERED_STEP
+    if(drawn_stepped(x, y)) {
+        m.x += drawn_step_x;
+        m.y += drawn_step_y;
+    }
+#endif
+    return m;
+}
+
+//Draw what the game logic reported since the last call, in order, as
+//far as left cycles go: the rest waits in the ring for the next frame.
+uint32_t draw_events(uint32_t left) {
+    uint8_t n;
+    events_budget = left;
+    events_spent = explosions_cost(FALSE);
+    events_forced = TRUE;
+    end_explosions(FALSE);
+    for(n = events_count(&play_events); n; n--) {
+        if(!draw_event(events_peek(&play_events, 0))) {
+            render_unfinished();
+            break;
         }
+        events_pop(&play_events);
     }
-    
-    if(change_topmost)
-        last_top_o = top_o;
-    if(change_leftmost) {
-        last_left_o = left_o;
-        monster_drawing ^= 1;
+    return events_spent;
+}
+
+//Draw an event, FALSE if it does not fit (a step may be part drawn).
+uint8_t draw_event(render_event *e) {
+    if(e->type == EV_FORMATION_STEP)
+        return step_monsters(e->a, e->b);
+    if(!events_fit(event_cost(e)))
+        return FALSE;
+    switch(e->type) {
+        case EV_MONSTER_KILLED:
+            explode_monster(e->a);
+            break;
+#ifdef STAGGERED_STEP
+        case EV_MONSTER_STEP:
+            step_monster(e->a);
+            break;
+#endif
+        case EV_HOUSE_HIT:
+            lcd_stats_category(STATS_HOUSES);
+            dl_fill_rectangle_c(houses[e->a].x + ((e->b & 0x0F) << 1),
+                                houses[e->a].y + ((e->b >> 4) << 1), 2, 2, BLACK);
+            break;
     }
+    return TRUE;
 }
 
+//Spend cost cycles of draw_events() if they fit. The first piece of a
+//frame always does, so that a job carried over makes progress.
+uint8_t events_fit(uint32_t cost) {
+    if(!events_forced && events_spent + cost > events_budget)
+        return FALSE;
+    if(cost)
+        events_forced = FALSE;
+    events_spent += cost;
+    return TRUE;
+}
+
+#ifdef STAGGERED_STEP
+//A new sweep: the last one has moved every monster drawn.
+uint8_t step_monsters(int8_t dx, int8_t dy) {
+    if(drawn_cursor) {
+        drawn_left_o += drawn_step_x;
+        drawn_top_o += drawn_step_y;
+        monster_frame ^= 1;
+    }
+    drawn_cursor = 0;
+    drawn_step_x = dx;
+    drawn_step_y = dy;
+    return TRUE;
+}
+
+//Step monster i (x * MONSTERS_Y + y) of the sweep, clearing the
+//explosions it moves into first.
+void step_monster(uint8_t i) {
+    uint8_t x = i / MONSTERS_Y, y = i % MONSTERS_Y, e;
+    uint8_t move = MONSTER_MOVE(drawn_step_x, drawn_step_y);
+    sprite m = drawn_monster(x, y), to = m;
+    lcd_stats_category(STATS_MONSTERS);
+    to.x += drawn_step_x;
+    to.y += drawn_step_y;
+    for(e = 0; e < MAX_EXPLOSIONS; e++) {
+        if(explosions[e].alive && intersect_sprite(explosions[e], MONSTER_WIDTH, MONSTER_HEIGHT,
+                                                   to, MONSTER_WIDTH, MONSTER_HEIGHT)) {
+            dl_fill_spans(explosions[e].x, explosions[e].y,
+                monster_sprite_exp_spans, display.background);
+            explosions[e].alive = FALSE;
+        }
+    }
+    draw_monster_step(&m, move, y);
+    drawn_cursor = STEP_ORDER(x, y) + 1;
+}
+#else
+//Formation step: only the pixels that change, as many monsters as fit
+//in the frame. FALSE until all of them are drawn.
+uint8_t step_monsters(int8_t dx, int8_t dy) {
+    uint8_t x, y;
+    uint8_t move = MONSTER_MOVE(dx, dy);
+    sprite m;
+    lcd_stats_category(STATS_MONSTERS);
+    if(!step_begun) {
+        //The row above an explosion steps down into it
+        if(!events_fit(explosions_cost(TRUE)))
+            return FALSE;
+        end_explosions(TRUE);
+        drawn_left_o += dx;
+        drawn_top_o += dy;
+        step_begun = TRUE;
+    }
+    for(; step_cell < STEP_CELLS; step_cell++) {
+        x = STEP_X(step_cell);
+        y = STEP_Y(step_cell);
+        if(!(monsters_drawn & ((uint32_t)1 << (x * MONSTERS_Y + y))))
+            continue;
+        if(!events_fit(monster_step_cost(y, move)))
+            return FALSE;
+        m = drawn_monster(x, y);
+        draw_monster_step(&m, move, y);
+    }
+    step_begun = FALSE;
+    step_cell = 0;
+    monster_frame ^= 1;
+    return TRUE;
+}
+#endif
+
+//Replace monster i (x * MONSTERS_Y + y) with an explosion.
+void explode_monster(uint8_t i) {
+    uint8_t e, last = 0;
+    sprite m = drawn_monster(i / MONSTERS_Y, i % MONSTERS_Y);
+    lcd_stats_category(STATS_MONSTERS);
+    monsters_drawn &= ~((uint32_t)1 << i);
+    monsters_drawn_count--;
+    erase_monster(&m, monster_frame ^ drawn_stepped(i / MONSTERS_Y, i % MONSTERS_Y));
+    dl_fill_image_pgm_spans(m.x, m.y, monster_sprite_exp_spans,
+                            monster_sprite_exp_idx, monster_sprite_exp_pal);
+    //A free slot, or the explosion closest to its end
+    for(e = 0; e < MAX_EXPLOSIONS && explosions[e].alive; e++)
+        if(explosions[e].alive < explosions[last].alive)
+            last = e;
+    if(e == MAX_EXPLOSIONS) {
+        e = last;
+        dl_fill_spans(explosions[e].x, explosions[e].y,
+            monster_sprite_exp_spans, display.background);
+    }
+    explosions[e] = m;
+    explosions[e].alive = EXPLOSION_FRAMES;
+}
+
+//Count down the explosions, and clear those at their end (all of them).
+void end_explosions(uint8_t all) {
+    uint8_t e;
+    for(e = 0; e < MAX_EXPLOSIONS; e++) {
+        if(explosions[e].alive && (all || !--explosions[e].alive)) {
+            lcd_stats_category(STATS_MONSTERS);
+            dl_fill_spans(explosions[e].x, explosions[e].y,
+                monster_sprite_exp_spans, display.background);
+            explosions[e].alive = FALSE;
+        }
+    }
+}
+
+//Lasers are redrawn whole every frame, over what they hide.
 void draw_monster_lasers(void) {
-    uint8_t l, h;
+    uint8_t l;
+    rectangle r;
     for(l = 0; l < MAX_MONSTER_LASERS; l++) {
         if(monster_lasers[l].alive) {
-            h = (monster_lasers[l].y - last_monster_lasers[l].y) > LASER_HEIGHT;
-            //Clear
-            fill_rectangle_c(monster_lasers[l].x,
-                             last_monster_lasers[l].y,
-                             LASER_WIDTH,
-                             h ? LASER_HEIGHT : monster_lasers[l].y - last_monster_lasers[l].y,
-                             display.background);
-            //Draw
-            fill_rectangle_c(monster_lasers[l].x,
-                             h ? monster_lasers[l].y : last_monster_lasers[l].y + LASER_HEIGHT,
-                             LASER_WIDTH,
-                             h ? LASER_HEIGHT : monster_lasers[l].y - last_monster_lasers[l].y,
-                             RED);
-            last_monster_lasers[l] = monster_lasers[l];
-        } else if(last_monster_lasers[l].alive) { //Has just died
-            fill_rectangle_c(last_monster_lasers[l].x,
-                           last_monster_lasers[l].y,
-                           LASER_WIDTH, LASER_HEIGHT,
-                           display.background);
-            last_monster_lasers[l] = monster_lasers[l];
+            r.left = monster_lasers[l].x;
+            r.right = monster_lasers[l].x + LASER_WIDTH - 1;
+            r.top = monster_lasers[l].y;
+            r.bottom = monster_lasers[l].y + LASER_HEIGHT - 1;
+            save_under_area(&monster_laser_under[l], r);
+            dl_fill_rectangle(r, RED);
         }
+        last_monster_lasers[l] = monster_lasers[l];
     }
 }
 
 void draw_lasers(void) {
+    rectangle r;
     if(cannon_laser.alive) {
-        //Clear
-        uint8_t h = (last_cannon_laser.y - cannon_laser.y) > LASER_HEIGHT;
-        fill_rectangle_c(cannon_laser.x,
-                         h ? last_cannon_laser.y : cannon_laser.y + LASER_HEIGHT,
-                         LASER_WIDTH, 
-                         h ? LASER_HEIGHT : last_cannon_laser.y - cannon_laser.y,
-                         display.background);
-        //Draw
-        fill_rectangle_c(cannon_laser.x,
-                         cannon_laser.y,
-                         LASER_WIDTH,
-                         h ? LASER_HEIGHT : last_cannon_laser.y - cannon_laser.y,
-                         BLUE);
-        last_cannon_laser = cannon_laser;
-    } else if(last_cannon_laser.alive) { //Has just died
-        fill_rectangle_c(last_cannon_laser.x,
-                       last_cannon_laser.y,
-                       LASER_WIDTH, LASER_HEIGHT,
-                       display.background);
-        last_cannon_laser = cannon_laser;
+        r.left = cannon_laser.x;
+        r.right = cannon_laser.x + LASER_WIDTH - 1;
+        r.top = cannon_laser.y;
+        r.bottom = cannon_laser.y + LASER_HEIGHT - 1;
+        save_under_area(&cannon_laser_under, r);
+        dl_fill_rectangle(r, BLUE);
     }
+    last_cannon_laser = cannon_laser;
 }
 
-void draw_score(void) {
-    display_uint16_xy(score, 250, 5);
+//Take the lasers off the screen, in the reverse order of drawing.
+void restore_lasers(void) {
+    int8_t l;
+    restore_under(&cannon_laser_under);
+    for(l = MAX_MONSTER_LASERS - 1; l >= 0; l--)
+        restore_under(&monster_laser_under[l]);
 }
 
-void draw_lives(void) {
-    uint16_t heart_offset;
+//The HUD area has just been cleared.
+void hud_reset(void) {
     uint8_t i;
-    for(i = 0, heart_offset = 280; i < lives; i++, heart_offset += 13) {
-        fill_image_pgm(heart_offset, 5, HEART_WIDTH, HEART_HEIGHT, heart_sprite);
+    for(i = 0; i < SCORE_DIGITS; i++)
+        hud_score[i] = ' ';
+    hud_score[SCORE_DIGITS] = '\0';
+    hud_lives = 0;
+}
+
+//Repaint the score digits and the hearts that changed since the last
+//call, nothing at all when score and lives are the same.
+void draw_hud(void) {
+    char b[SCORE_DIGITS + 2];
+    uint8_t i, first, last;
+    shorttoa(score, b);
+    for(i = 0; b[i]; i++);
+    for(; i < SCORE_DIGITS; i++)
+        b[i] = ' ';
+    b[SCORE_DIGITS] = '\0';
+    for(first = 0; first < SCORE_DIGITS && b[first] == hud_score[first]; first++);
+    if(first < SCORE_DIGITS) {
+        for(last = SCORE_DIGITS - 1; b[last] == hud_score[last]; last--);
+        for(i = first; i <= last; i++)
+            hud_score[i] = b[i];
+        b[last + 1] = '\0';
+        display_string_xy(b + first, SCORE_X + 6 * first, SCORE_Y);
+    }
+
+    for(; hud_lives < lives; hud_lives++) {
+        fill_image_pgm_indexed(HEARTS_X + HEART_SPACING * hud_lives, HEARTS_Y,
+                               HEART_WIDTH, HEART_HEIGHT,
+                               heart_sprite_idx, heart_sprite_pal);
     }
-    for(;i < 3; i++, heart_offset += 13) {
-        fill_rectangle_c(heart_offset, 5, HEART_WIDTH, HEART_HEIGHT, display.background);
+    for(; hud_lives > lives; hud_lives--) {
+        fill_rectangle_c(HEARTS_X + HEART_SPACING * (hud_lives - 1), HEARTS_Y,
+                         HEART_WIDTH, HEART_HEIGHT, display.background);
     }
 }
 
-void draw_houses(void) {
-    uint8_t x, y, h;
-    for(h = 0; h < HOUSE_COUNT; h++) {
-        for(y = 0; y < HOUSE_HEIGHT >> 1; y++) {
-            for(x = 0; x < HOUSE_WIDTH >> 1; x++) {
-                // !(house_1[y/2+x/8] & (128 >> x%8))
-                uint8_t index = (y<<1) + (x>>3);
-                uint8_t offset = 128 >> (x & 0x07);
-                if((house_data[h][index] & offset) != (old_house_data[h][index] & offset)) {
-                    fill_rectangle_c(houses[h].x + (x<<1),
-                                     houses[h].y + (y<<1), 2, 2, BLACK);
-                    old_house_data[h][index] = house_data[h][index];
-                }
-            }
+#ifdef DL_DEBUG
+//Pixels requested by the draw functions / pixels actually sent
+//to the screen during the last frame, then the address setup bytes
+//sent / skipped by the window shadow in the same frame, then the
+//estimated drawing cycles / budget and the jobs carried over so far.
+void draw_dl_stats(void) {
+    display.x = 5;
+    display.y = 5;
+    display_uint32(display_list_stats.requested);
+    display_char('/');
+    display_uint32(display_list_stats.sent);
+    display_string("    ");
+    display.x = 5;
+    display.y = 14;
+    display_uint16(frame_window_stats.sent);
+    display_char('/');
+    display_uint16(frame_window_stats.saved);
+    display_string("    ");
+    display.x = 5;
+    display.y = 23;
+    display_uint32(render_frame_stats.used);
+    display_char('/');
+    display_uint32(render_frame_stats.budget);
+    display_char(' ');
+    display_uint16(render_frame_stats.carried_total);
+    display_char(' ');
+    display_uint16(render_frame_stats.overruns);
+    display_string("    ");
+}
+#endif
+
+#ifdef LCD_STATS
+//Bus traffic of the last play frame by category (Score and lives,
+//Monsters, Lasers, Houses, Other): command bytes, memory writes,
+//pixels and data bytes, with frames per second and the drawing time.
+//Two columns of three lines below the houses.
+void draw_bus_stats(void) {
+    static const char labels[LCD_STATS_CATEGORIES][2] = {"S", "M", "L", "H", "O"};
+    uint8_t i, line;
+    if(!stats_overlay) {
+        if(stats_shown) {
+            fill_rectangle_c(0, STATS_Y, LCDWIDTH, 3 * 8, display.background);
+            stats_shown = FALSE;
         }
+        return;
+    }
+    stats_shown = TRUE;
+    display.x = 0;
+    display.y = STATS_Y;
+    display_uint8(stats_fps);
+    display_string("fps ");
+    display_uint16(stats_isr_us);
+    display_string("us t");
+    display_uint16(tasks[TASK_TICK].missed);
+    display_string(" f");
+    display_uint16(tasks[TASK_FRAME].missed);
+    display_string("  ");
+    for(i = 0; i < LCD_STATS_CATEGORIES; i++) {
+        line = i + 1;
+        display.x = line < 3 ? 0 : LCDWIDTH / 2;
+        display.y = STATS_Y + 8 * (line % 3);
+        display_string((char *)labels[i]);
+        display_string(" c");
+        display_uint16(frame_bus_stats[i].commands);
+        display_string(" w");
+        display_uint16(frame_bus_stats[i].windows);
+        display_string(" p");
+        display_uint32(frame_bus_stats[i].pixels);
+        display_string(" d");
+        display_uint32(frame_bus_stats[i].bytes);
+        display_char(' ');
+    }
+}
+#endif
+
+//Estimated cycles of the draw functions, see render.h.
+uint32_t cannon_cost(void) {
+    uint16_t w;
+    if(!last_cannon.alive)
+        return render_cost(1, CANNON_WIDTH * CANNON_HEIGHT);
+    if(last_cannon.x == cannon.x)
+        return 0;
+    w = cannon.x > last_cannon.x ? cannon.x - last_cannon.x : last_cannon.x - cannon.x;
+    if(w > CANNON_WIDTH)
+        w = CANNON_WIDTH;
+    return render_cost(2, (w + CANNON_WIDTH) * CANNON_HEIGHT);
+}
+
+//Explosions ending, then the first piece of the events waiting: the
+//rest is drawn as far as the budget goes, see draw_events().
+uint32_t events_cost(void) {
+    uint32_t cost = explosions_cost(FALSE);
+    if(events_count(&play_events))
+        cost += event_cost(events_peek(&play_events, 0));
+    return cost;
+}
+
+//Cycles of the next piece of an event: a formation step goes monster
+//by monster, after the explosions.
+uint32_t event_cost(render_event *e) {
+#ifndef STAGGERED_STEP
+    uint8_t cell;
+    uint32_t cost = 0;
+#endif
+    switch(e->type) {
+#ifdef STAGGERED_STEP
+        case EV_MONSTER_STEP:
+            return monster_step_cost(e->a % MONSTERS_Y, MONSTER_MOVE(drawn_step_x, drawn_step_y));
+#else
+        case EV_FORMATION_STEP:
+            if(!step_begun)
+                cost = explosions_cost(TRUE);
+            for(cell = step_cell; cell < STEP_CELLS; cell++)
+                if(monsters_drawn & ((uint32_t)1 << (STEP_X(cell) * MONSTERS_Y + STEP_Y(cell))))
+                    return cost + monster_step_cost(STEP_Y(cell), MONSTER_MOVE((int8_t)e->a, e->b));
+            return cost;
+#endif
+        case EV_MONSTER_KILLED:
+            return explode_cost(e->a);
+        case EV_HOUSE_HIT:
+            return render_cost(1, 4);
     }
+    return 0;
 }
 
-void draw_monster(volatile sprite *monster, uint8_t version) {
-    if(monster->kind == 0) {
-        if(version == 0) {
-            fill_image_pgm_2b(
-                monster->x, monster->y,
-                MONSTER_WIDTH, MONSTER_HEIGHT,
-                monster_sprite_1A);
-        } else {
-            fill_image_pgm_2b(
-                monster->x, monster->y,
-                MONSTER_WIDTH, MONSTER_HEIGHT,
-                monster_sprite_1B);
-        }
-    } else if(monster->kind == 1) {
-        if(version == 0) {
-            fill_image_pgm_2b(
-                monster->x, monster->y,
-                MONSTER_WIDTH, MONSTER_HEIGHT,
-                monster_sprite_2A);
-        } else {
-            fill_image_pgm_2b(
-                monster->x, monster->y,
-                MONSTER_WIDTH, MONSTER_HEIGHT,
-                monster_sprite_2B);
-        }
-    } else if(monster->kind == 2) {
-        if(version == 0) {
-            fill_image_pgm_2b(
-                monster->x, monster->y,
-                MONSTER_WIDTH, MONSTER_HEIGHT,
-                monster_sprite_3A);
-        } else {
-            fill_image_pgm_2b(
-                monster->x, monster->y,
-                MONSTER_WIDTH, MONSTER_HEIGHT,
-                monster_sprite_3B);
+//Only the pixels drawn: the strip uncovered and the sprite, or spans.
+uint32_t astro_cost(void) {
+    uint32_t cost = 0;
+    if(astro.alive) {
+        if(last_astro.x != astro.x && astro.alive <= 2) {
+            cost += render_cost(1, (astro.x - last_astro.x) * ASTRO_HEIGHT);
+            if(astro.alive == 1)
+                cost += render_cost(1, ASTRO_WIDTH * ASTRO_HEIGHT);
         }
+        if(astro.alive == 2)
+            cost += spans_cost(astro_sprite_spans) + spans_cost(monster_sprite_exp_spans);
+        else if(astro.alive >= 10)
+            cost += spans_cost(monster_sprite_exp_spans);
+    } else if(last_astro.alive) {
+        cost = render_cost(1, ASTRO_WIDTH * ASTRO_HEIGHT);
     }
+    return cost;
+}
+
+//A window per span and the pixels on screen, from the header of the
+//span table (tools/spritec.py): count first, pixels in bytes 9 and 10.
+uint32_t spans_cost(const uint8_t *spans) {
+    return render_cost(pgm_read_byte(spans), pgm_read_word(spans + 9));
+}
+
+//The explosions ending this frame, or all of them.
+uint32_t explosions_cost(uint8_t all) {
+    uint8_t e, n = 0;
+    for(e = 0; e < MAX_EXPLOSIONS; e++)
+        if(explosions[e].alive && (all || explosions[e].alive == 1))
+            n++;
+    return n * spans_cost(monster_sprite_exp_spans);
+}
+
+//A monster of row y drawn with monster_frame stepping through its delta.
+uint32_t monster_step_cost(uint8_t y, uint8_t move) {
+    return spans_cost((const uint8_t *)pgm_read_word(&monster_deltas[MONSTER_KIND(y)][monster_frame][move]));
+}
+
+//Monster i erased and an explosion drawn in its place.
+uint32_t explode_cost(uint8_t i) {
+    uint8_t y = i % MONSTERS_Y;
+    const uint8_t *spans = (const uint8_t *)pgm_read_word(
+        &monster_spans[MONSTER_KIND(y)][monster_frame ^ drawn_stepped(i / MONSTERS_Y, y)]);
+    return spans_cost(spans) + spans_cost(monster_sprite_exp_spans);
+}
+
+//Move a monster drawn with monster_frame one step and flip its frame.
+void draw_monster_step(volatile sprite *monster, uint8_t move, uint8_t row) {
+    const uint8_t *spans = (const uint8_t *)pgm_read_word(&monster_deltas[monster->kind][monster_frame][move]);
+    const uint8_t *data = (const uint8_t *)pgm_read_word(&monster_sprites[monster->kind][monster_frame ^ 1]);
+    dl_fill_image_pgm_spans(monster->x, monster->y, spans, data, monster_palettes[row]);
+}
+
+//Draw only the pixels of the monster, leaving its background as it is.
+void draw_monster_over(volatile sprite *monster, uint8_t version, uint8_t row) {
+    const uint8_t *spans = (const uint8_t *)pgm_read_word(&monster_spans[monster->kind][version]);
+    const uint8_t *data = (const uint8_t *)pgm_read_word(&monster_sprites[monster->kind][version]);
+    dl_fill_image_pgm_spans(monster->x, monster->y, spans, data, monster_palettes[row]);
+}
+
+//Clear only the pixels of a monster drawn with version.
+void erase_monster(volatile sprite *monster, uint8_t version) {
+    const uint8_t *spans = (const uint8_t *)pgm_read_word(&monster_spans[monster->kind][version]);
+    dl_fill_spans(monster->x, monster->y, spans, display.background);
 }
 
 void draw_home_screen(void) {
     //character width = 10
-    uint8_t triangle_y;
+    uint8_t i;
     if(last_selected_item == selected_item)
         return;
-    clear_screen();
-    
-    display_string_xy_col("Play!", HIGH_SCORE_X, 90, selected_item == 0 ? BLUE : WHITE);
-    display_string_xy_col("High scores", HIGH_SCORE_X, 115, selected_item == 1 ? BLUE : WHITE);
-    display_string_xy_col("About", HIGH_SCORE_X, 140, selected_item == 2 ? BLUE : WHITE);
-    
-    switch(selected_item) {
-        case 0: triangle_y = 90;
-                break;
-        case 1: triangle_y = 115;
-                break;
-        case 2: triangle_y = 140;
-                break;
-        default: return;
+    if(last_selected_item < 0) { //Coming from another screen
+        clear_screen();
+        for(i = 0; i < HOME_SCREEN_ITEMS; i++)
+            draw_home_item(i);
+    } else { //Only the old and the new item change
+        draw_home_item(last_selected_item);
+        draw_home_item(selected_item);
+        fill_rectangle_c(HIGH_SCORE_X - TRIANGLE_WIDTH * 2, home_items_y[last_selected_item],
+                         TRIANGLE_WIDTH, TRIANGLE_HEIGHT, display.background);
     }
-    fill_image_pgm(HIGH_SCORE_X - TRIANGLE_WIDTH * 2, triangle_y, TRIANGLE_WIDTH, TRIANGLE_HEIGHT, triangle_sprite);
+    fill_image_pgm_indexed(HIGH_SCORE_X - TRIANGLE_WIDTH * 2, home_items_y[selected_item],
+                           TRIANGLE_WIDTH, TRIANGLE_HEIGHT,
+                           triangle_sprite_idx, triangle_sprite_pal);
     last_selected_item = selected_item;
 }
 
+void draw_home_item(uint8_t i) {
+    display_string_xy_col(home_items[i], HIGH_SCORE_X, home_items_y[i],
+                          i == selected_item ? BLUE : WHITE);
+}
+
+//Switch the panel to the idle/partial modes wanted by a game state.
+void set_display_policy(uint8_t state) {
+    display_policy p = display_policies[state];
+    idle_mode(p.idle);
+    if(p.first <= p.last)
+        set_partial_area(p.first, p.last);
+    partial_mode(p.first <= p.last);
+}
+
 void draw_high_scores(void) {
     uint8_t i, h;
     
-    if(is_drawn)
+    if(is_drawn) {
+        if(scroll_x)
+            scroll_high_scores();
         return;
+    }
     display_string_xy("HIGH SCORES (press left to go back)", 50, 5);
     //Assumes MAX_HIGH_SCORES >= 3
     h = 20;
@@ -546,6 +1141,23 @@ void draw_high_scores(void) {
     is_drawn = TRUE;
 }
 
+//Slide the high scores out to the left, one step per frame.
+//The panel scrolls along screen x, so each step is a single register
+//write plus blanking the strip that wraps round to the right edge.
+void scroll_high_scores(void) {
+    fill_rectangle_c(scroll_x - HIGH_SCORE_SCROLL, 0,
+                     HIGH_SCORE_SCROLL, LCDHEIGHT, display.background);
+    set_scroll_offset(scroll_x);
+    if(scroll_x < LCDWIDTH) {
+        scroll_x += HIGH_SCORE_SCROLL;
+    } else { //Screen is blank, and back to offset 0
+        scroll_x = 0;
+        last_selected_item = -1; // Force redraw of home screen
+        selected_item = 1;
+        game_state = STATE_HOME;
+    }
+}
+
 void draw_new_high_score(void) {
     draw_keyboard();
     if(is_drawn)
@@ -572,19 +1184,25 @@ void in_game_movement(void) {
     //stack space = 10B
     uint8_t x, y, l;
     uint8_t shoot, yinc;
-    int8_t last_alive_monster_y;
     int8_t rotary;
     rectangle r;
     static int8_t xinc = MONSTER_SPEED;
-    static uint16_t shot_p = 62700;
     static uint8_t monster_tick = 0;
+#ifdef LCD_STATS
+    if(get_switch_long(_BV(SWN)))
+        stats_overlay ^= TRUE;
+#endif
+    //Wait for the drawing to catch up rather than lose an event, and
+    //for the cannon to explode (a tick posted before Timer 1 stopped)
+    if(events_free(&play_events) < EVENTS_PER_TICK || lost_life)
+        return;
     monster_tick = (monster_tick + 1) % DRAW_MONSTERS_TICK;
        
     //Cannon-Monster laser collision, and monster laser moving
     for(l = 0; l < MAX_MONSTER_LASERS; l++) {
         if(monster_lasers[l].alive) {
             monster_lasers[l].y += MONSTER_LASER_SPEED;
-            if(monster_lasers[l].y >= LCDHEIGHT - LASER_HEIGHT) {
+            if(monster_lasers[l].y + LASER_HEIGHT > LCDHEIGHT) {
                 monster_lasers[l].alive = FALSE;
             } else if(intersect_sprite(cannon, CANNON_WIDTH, CANNON_HEIGHT,
                         monster_lasers[l], LASER_WIDTH, LASER_HEIGHT)) { //Colision with cannon
@@ -604,6 +1222,7 @@ void in_game_movement(void) {
                             uint16_t tempx = (r.left - houses[x].x) >> 1;
                             uint16_t tempy = (r.bottom - houses[x].y) >> 1;
                             house_data[x][(tempy << 1) + (tempx>>3)] &= ~(128 >> (tempx & 0x07));
+                            events_push(&play_events, EV_HOUSE_HIT, x, (tempy << 4) | tempx);
                             monster_lasers[l].alive = FALSE;
                         }
                     }
@@ -630,87 +1249,79 @@ void in_game_movement(void) {
                     uint16_t tempx = ((r.left - houses[x].x) >> 1);
                     uint16_t tempy = ((r.top - houses[x].y) >> 1);
                     house_data[x][(tempy << 1) + (tempx>>3)] &= ~(128 >> (tempx & 0x07));
+                    events_push(&play_events, EV_HOUSE_HIT, x, (tempy << 4) | tempx);
                     cannon_laser.alive = FALSE;
                 }
             }
         }
     } else if (shoot && !last_cannon_laser.alive) { //Ensure that 1 drawing cycle occurs before drawing again.
         //Cannon Shoot
-        cannon_laser.x = cannon.x + (CANNON_WIDTH / 2) - LASER_WIDTH/2;
+        cannon_laser.x = cannon.x + (CANNON_WIDTH - LASER_WIDTH) / 2;
         cannon_laser.y = cannon.y - LASER_HEIGHT;
         cannon_laser.alive = TRUE;
         last_cannon_laser = cannon_laser;
     }
     
     //Monster-Cannon shot collision
-    for(x = 0; x < MONSTERS_X; x++) {
-        for(y = 0; y < MONSTERS_Y; y++) {
-            if(monsters[x][y].alive == 1) {              
-                //Collision
-                if(cannon_laser.alive && 
-                   intersect_sprite(cannon_laser, LASER_WIDTH, LASER_HEIGHT,
-                                    monsters[x][y], MONSTER_WIDTH, MONSTER_HEIGHT)) {
-                    cannon_laser.alive = FALSE;
-                    monsters[x][y].alive = 2;
-                    score += MONSTER_POINTS;
-                }
-            }
-        }
+    if(cannon_laser.alive && laser_hits_monster(&x, &y)) {
+        cannon_laser.alive = FALSE;
+        kill_monster(x, y);
+        events_push(&play_events, EV_MONSTER_KILLED, x * MONSTERS_Y + y, 0);
+        score += MONSTER_POINTS;
     }
    
     //Monsters moving & shooting
+#ifdef STAGGERED_STEP
+    if(!monster_tick && step_cursor == STEP_CELLS) {
+#else
     if(!monster_tick) {
+#endif
         yinc = 0;
         if(leftmost < MONSTER_PADDING_X || rightmost > LCDWIDTH - MONSTER_PADDING_X) {
             xinc = -xinc;
             yinc = MONSTER_SPEED;
             shot_p -= 50;
         }
-        has_monsters = 0;
-        rightmost = bottommost = 0;
-        leftmost = topmost = LCDWIDTH;
-        
-        for(x = 0; x < MONSTERS_X; x++) {
-            last_alive_monster_y = -1;
-            for(y = 0; y < MONSTERS_Y; y++) {
-                if(monsters[x][y].alive == 1) {
-                    last_alive_monster_y = y;
-                    has_monsters = 1;
-                    monsters[x][y].x += xinc;
-                    monsters[x][y].y += yinc;
-                    //Die when monsters get past cannon
-                    if(monsters[x][y].y + MONSTER_HEIGHT >= cannon.y) {
-                        lives = 0;
-                        return;
-                    }
-                    has_monsters = 1;
-                    //Update left/right/top/bottommost
-                    if(monsters[x][y].x + MONSTER_WIDTH > rightmost)
-                        rightmost = monsters[x][y].x + MONSTER_WIDTH;
-                    if(monsters[x][y].x < leftmost)
-                        leftmost = monsters[x][y].x;
-                    if(monsters[x][y].y + MONSTER_HEIGHT > bottommost)
-                        bottommost = monsters[x][y].y + MONSTER_HEIGHT;
-                    if(monsters[x][y].y < topmost)
-                        topmost = monsters[x][y].y;
-                }
-            }
-            //Monster shoot
-            if(last_alive_monster_y >= 0 && rand() > shot_p) {
-                for(l = 0; l < MAX_MONSTER_LASERS; l++) {
-                    if(!monster_lasers[l].alive && !last_monster_lasers[l].alive) {
-                        monster_lasers[l].x = monsters[x][last_alive_monster_y].x + (MONSTER_WIDTH / 2);
-                        monster_lasers[l].y = monsters[x][last_alive_monster_y].y + MONSTER_HEIGHT + 1;
-                        monster_lasers[l].alive = TRUE;
-                        last_monster_lasers[l] = monster_lasers[l];
-                        break;
-                    }
-                }
-            }
+        has_monsters = monsters_alive != 0;
+        if(!has_monsters) {
+            game_state = STATE_GAME_WON;
+            return;
         }
         left_o += xinc;
         top_o += yinc;
+        leftmost += xinc;
+        rightmost += xinc;
+        topmost += yinc;
+        bottommost += yinc;
+        //Die when monsters get past cannon
+        if(bottommost >= cannon.y) {
+            lives = 0;
+            lost_life = TRUE;
+            TIMSK1 &= ~_BV(OCIE1A);
+            return;
+        }
+        
+#ifdef STAGGERED_STEP
+        step_cursor = 0;
+        sweep_x = xinc;
+        sweep_y = yinc;
+#else
+        for(x = 0; x < MONSTERS_X; x++)
+            monster_shoot(x);
+#endif
+        events_push(&play_events, EV_FORMATION_STEP, xinc, yinc);
     }
+#ifdef STAGGERED_STEP
+    //One monster of the sweep per tick, the shooter of its column shoots
+    if(!monster_tick && (step_cursor = skip_dead(step_cursor)) < STEP_CELLS) {
+        x = STEP_X(step_cursor);
+        y = STEP_Y(step_cursor);
+        events_push(&play_events, EV_MONSTER_STEP, x * MONSTERS_Y + y, 0);
+        if(monster_shooters[x] == y)
+            monster_shoot(x);
+        step_cursor = skip_dead(step_cursor + 1);
+    }
+#endif
     
     //Astro creation (and moving/collision)
     if(astro.alive == 1) {
@@ -777,12 +1388,9 @@ void home_screen_movement(void) {
 }
 
 void high_score_movement(void) {
-    if(get_switch_short(_BV(SWW))) { //Go back
-        clear_screen();
-        last_selected_item = -1; // Force redraw of home screen
-        selected_item = 1;
+    if(!scroll_x && get_switch_short(_BV(SWW))) { //Go back
         clear_switches();
-        game_state = STATE_HOME;
+        scroll_x = HIGH_SCORE_SCROLL; //draw_high_scores returns home
     }
 }
 
@@ -806,21 +1414,27 @@ void new_high_score_movement(void) {
     }
 }
 
-//Displays the blinking cannon and performs some book-keeping when
-//a life is lost.
-void life_lost_sequence(void) {
-    uint8_t frames = 7;
-    draw_lives();
-    while(frames--) {
-        fill_image_pgm(cannon.x, cannon.y,
-                       CANNON_WIDTH, CANNON_HEIGHT,
-                       cannon_sprite_2);
-        _delay_ms(75);
-        fill_image_pgm(cannon.x, cannon.y,
-                       CANNON_WIDTH, CANNON_HEIGHT,
-                       cannon_sprite_3);
-        _delay_ms(75);
+//Blinks the cannon, a frame at a time, then performs some book-keeping
+//when a life is lost: the game carries on, or is over.
+void life_lost_frame(void) {
+    static uint8_t frame = 0;
+    if(!frame)
+        restore_lasers();
+    if(frame < LIFE_LOST_BLINKS * BLINK_FRAMES) {
+        if(!(frame % BLINK_FRAMES)) {
+            if((frame / BLINK_FRAMES) & 1)
+                fill_image_pgm_indexed(cannon.x, cannon.y,
+                               CANNON_WIDTH, CANNON_HEIGHT,
+                               cannon_sprite_3_idx, cannon_sprite_3_pal);
+            else
+                fill_image_pgm_indexed(cannon.x, cannon.y,
+                               CANNON_WIDTH, CANNON_HEIGHT,
+                               cannon_sprite_2_idx, cannon_sprite_2_pal);
+        }
+        frame++;
+        return;
     }
+    frame = 0;
     fill_rectangle_c(last_cannon.x, last_cannon.y,
                    CANNON_WIDTH, CANNON_HEIGHT,
                    display.background);
@@ -829,20 +1443,60 @@ void life_lost_sequence(void) {
                    display.background);
     lost_life = FALSE;
     cannon = last_cannon = start_cannon;
+    last_cannon.alive = FALSE;
     //Clear the switches to prevent random firing as soon as game restarts.
     get_switch_rpt(_BV(SWC)); 
     get_switch_short(_BV(SWC));
     reset_sprites();
+    if(!lives) {
+        clear_screen();
+        display_string_xy("Game Over (press center to play again)", 20, 150);
+        PORTB |= _BV(PB6);
+        game_state = STATE_GAME_OVER;
+    }
     TIMSK1 |= _BV(OCIE1A);
 }
 
+//Shows the win for a moment, then asks for the name of a high score.
+void game_won_frame(void) {
+    static uint8_t frame = 0;
+    if(!frame)
+        display_string_xy("YOU WIN!", 130, 150);
+    if(++frame < GAME_WON_FRAMES)
+        return;
+    frame = 0;
+    if(is_high_score(score)) {
+        clear_screen();
+        is_drawn = FALSE;
+        init_keyboard();
+        game_state = STATE_NEW_HIGH_SCORE;
+    } else {
+        last_selected_item = -1;
+        game_state = STATE_HOME;
+    }
+}
+
+void game_over_movement(void) {
+    if(PINB % _BV(PB6))
+        LED_ON;
+    else
+        LED_OFF;
+    if(get_switch_short(_BV(SWC))) {
+        last_selected_item = -1;
+        game_state = STATE_HOME;
+    }
+}
+
 
 //Reset sprites on life lost (lasers, and astro)
 void reset_sprites(void) {
     uint8_t l;
     cannon_laser.alive = FALSE;
+    cannon_laser_under.saved = FALSE;
     for(l = 0; l < MAX_MONSTER_LASERS; l++) {
         monster_lasers[l].alive = FALSE;
+        monster_laser_under[l].saved = FALSE;
+        monster_laser_under[l].buf = monster_laser_pixels[l];
     }
     astro.alive = FALSE;
 }
@@ -850,12 +1504,126 @@ void reset_sprites(void) {
 //Detect whether 2 rectangles intersect.
 static inline uint8_t intersect_sprite(sprite s1, uint8_t w1, uint8_t h1, 
                                        sprite s2, uint8_t w2, uint8_t h2) {
-    return !(s2.x > s1.x + w1
-        || s2.x + w2 < s1.x
-        || s2.y > s1.y + h1
-        || s2.y + h2 < s1.y);
+    return !(s2.x >= s1.x + w1
+        || s2.x + w2 <= s1.x
+        || s2.y >= s1.y + h1
+        || s2.y + h2 <= s1.y);
+}
+
+//Where the monster at x, y of the formation is.
+static inline sprite formation_monster(uint8_t x, uint8_t y) {
+    sprite m;
+    m.x = CELL_X(x) + left_o;
+    m.y = CELL_Y(y) + top_o;
+    m.alive = 1;
+    m.kind = MONSTER_KIND(y);
+#ifdef STAGGERED_STEP
+    if(STEP_ORDER(x, y) >= step_cursor) {
+        m.x -= sweep_x;
+        m.y -= sweep_y;
+    }
+#endif
+    return m;
 }
 
+//Find the alive monster the cannon laser hits, in hx, hy. Alive
+//monsters are on a grid from left_o, top_o, so only the cells the
+//laser overlaps are tested: one or two columns and rows.
+uint8_t laser_hits_monster(uint8_t *hx, uint8_t *hy) {
+    int16_t dx0 = cannon_laser.x - left_o, dx1 = dx0;
+    int16_t dy0 = cannon_laser.y - top_o, dy1 = dy0;
+    int16_t x, y, x0, y0, x1, y1;
+    sprite m;
+#ifdef STAGGERED_STEP
+    //The rest of the sweep is one step behind the origin
+    if(step_cursor < STEP_CELLS) {
+        if(sweep_x < 0)
+            dx0 += sweep_x;
+        else
+            dx1 += sweep_x;
+        dy1 += sweep_y;
+    }
+#endif
+    if(dx1 + LASER_WIDTH <= 0 || dy1 + LASER_HEIGHT <= 0)
+        return FALSE;
+    x0 = dx0 < 0 ? 0 : dx0 / CELL_X(1);
+    y0 = dy0 < 0 ? 0 : dy0 / CELL_Y(1);
+    x1 = (dx1 + LASER_WIDTH - 1) / CELL_X(1);
+    y1 = (dy1 + LASER_HEIGHT - 1) / CELL_Y(1);
+    if(x1 >= MONSTERS_X)
+        x1 = MONSTERS_X - 1;
+    if(y1 >= MONSTERS_Y)
+        y1 = MONSTERS_Y - 1;
+    for(x = x0; x <= x1; x++) {
+        for(y = y0; y <= y1; y++) {
+            m = formation_monster(x, y);
+            if((monster_columns[x] & _BV(y))
+               && intersect_sprite(cannon_laser, LASER_WIDTH, LASER_HEIGHT,
+                                   m, MONSTER_WIDTH, MONSTER_HEIGHT)) {
+                *hx = x;
+                *hy = y;
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+//The shooter of the column moves up past the empty rows, and the
+//bounds move in when an edge column or row is emptied.
+void kill_monster(uint8_t x, uint8_t y) {
+    int8_t r = monster_shooters[x];
+    monster_columns[x] &= ~_BV(y);
+    monster_rows[y]--;
+    while(r >= 0 && !(monster_columns[x] & _BV(r)))
+        r--;
+    monster_shooters[x] = r;
+    if(!--monsters_alive)
+        return;
+    if(!monster_columns[x]) {
+        while(!monster_columns[first_column])
+            first_column++;
+        while(!monster_columns[last_column])
+            last_column--;
+        leftmost = CELL_X(first_column) + left_o;
+        rightmost = CELL_X(last_column) + left_o + MONSTER_WIDTH;
+    }
+    if(!monster_rows[y]) {
+        while(!monster_rows[top_row])
+            top_row++;
+        while(!monster_rows[bottom_row])
+            bottom_row--;
+        topmost = CELL_Y(top_row) + top_o;
+        bottommost = CELL_Y(bottom_row) + top_o + MONSTER_HEIGHT;
+    }
+}
+
+//The shooter of column x fires, now and then, if a laser is free.
+void monster_shoot(uint8_t x) {
+    uint8_t l;
+    int8_t shooter = monster_shooters[x];
+    if(shooter < 0 || rand() <= shot_p)
+        return;
+    for(l = 0; l < MAX_MONSTER_LASERS; l++) {
+        if(!monster_lasers[l].alive && !last_monster_lasers[l].alive) {
+            monster_lasers[l].x = CELL_X(x) + left_o + (MONSTER_WIDTH - LASER_WIDTH) / 2;
+            monster_lasers[l].y = CELL_Y(shooter) + top_o + MONSTER_HEIGHT + 1;
+            monster_lasers[l].alive = TRUE;
+            last_monster_lasers[l] = monster_lasers[l];
+            return;
+        }
+    }
+}
+
+#ifdef STAGGERED_STEP
+//The first cell of the sweep from c with a monster, STEP_CELLS if none.
+uint8_t skip_dead(uint8_t c) {
+    while(c < STEP_CELLS && !(monster_columns[STEP_X(c)] & _BV(STEP_Y(c))))
+        c++;
+    return c;
+}
+#endif
+
 //Calculate pixel-perfect collision between sprite s1 and s2.
 //Collision area is reported in the result rectangle.
 //TRUE is returned if an actual collision occurred.
@@ -867,12 +1635,12 @@ uint8_t intersect_pp(sprite s1, uint8_t w1, uint8_t h1,
     uint16_t tempx, tempy;
     if(s1.y > s2.y) top = s1.y;
     else top = s2.y;
-    if(s1.y+h1 > s2.y+h2) bottom = s2.y+h2;
-    else bottom = s1.y+h1;
+    if(s1.y+h1 > s2.y+h2) bottom = s2.y+h2-1;
+    else bottom = s1.y+h1-1;
     if(s1.x > s2.x) left = s1.x;
     else left = s2.x;
-    if(s1.x+w1 > s2.x+w2) right = s2.x+w2;
-    else right = s1.x+w1;
+    if(s1.x+w1 > s2.x+w2) right = s2.x+w2-1;
+    else right = s1.x+w1-1;
 
     //The divisions by 2 are because one bit in data represents 2 pixels.
     tempy = ((top - s2.y) >> 1);
@@ -997,6 +1765,9 @@ void os_init(void) {
     
     /* Frame rate */
 	set_frame_rate_hz(31); /* > 60 Hz  (KPZ 30.01.2015) */
+	set_idle_frame_rate_hz(16); /* static menus (idle and partial mode) */
+    render_init(play_jobs, sizeof(play_jobs) / sizeof(play_jobs[0]), RENDER_BUDGET);
+    sched_init(tasks, sizeof(tasks) / sizeof(tasks[0]));
     
 	/* Enable tearing interrupt to get flicker free display */
 	EIMSK |= _BV(INT6);
@@ -1019,34 +1790,58 @@ void os_init(void) {
 int main() {
     os_init();
     uint8_t x, y, h;
+    sprite m;
     do {
         game_state = STATE_HOME;
         last_selected_item = -1;
 		OCR1A = 6192;
         //Home screen loop
         sei();
-        while(game_state != STATE_PLAY);
+        while(game_state != STATE_PLAY)
+            sched_run();
         cli();
         
         reset_sprites();
         clear_screen();
         //Game loop
+        leftmost = left_o = drawn_left_o = MONSTER_PADDING_X;
+        rightmost = CELL_X(MONSTERS_X);
+        topmost = top_o = drawn_top_o = MONSTER_TOP;
+        bottommost = CELL_Y(MONSTERS_Y) + MONSTER_TOP - MONSTER_PADDING_Y;
+        first_column = top_row = 0;
+        last_column = MONSTERS_X - 1;
+        bottom_row = MONSTERS_Y - 1;
+#ifdef STAGGERED_STEP
+        step_cursor = STEP_CELLS;
+        drawn_cursor = 0;
+#endif
+        dl_begin();
         for(x = 0; x < MONSTERS_X; x++) {
             for(y = 0; y < MONSTERS_Y; y++) {
-                monsters[x][y].x = x*(MONSTER_WIDTH+MONSTER_PADDING_X)+MONSTER_PADDING_X;
-                monsters[x][y].y = y*(MONSTER_HEIGHT+MONSTER_PADDING_Y)+MONSTER_TOP;
-                monsters[x][y].alive = 1;
-                monsters[x][y].kind = y >> 1;
-                draw_monster(&monsters[x][y],0);
-                last_monsters[x][y] = monsters[x][y];
+                m = drawn_monster(x, y);
+                draw_monster_over(&m, 0, y);
             }
+            monster_columns[x] = _BV(MONSTERS_Y) - 1;
+            monster_shooters[x] = MONSTERS_Y - 1;
         }
+        dl_end();
+        for(y = 0; y < MONSTERS_Y; y++)
+            monster_rows[y] = MONSTERS_X;
+        monsters_alive = MONSTERS_X * MONSTERS_Y;
+        monster_frame = 0;
+        monsters_drawn = ((uint32_t)1 << (MONSTERS_X * MONSTERS_Y)) - 1;
+        monsters_drawn_count = MONSTERS_X * MONSTERS_Y;
+        for(x = 0; x < MAX_EXPLOSIONS; x++)
+            explosions[x].alive = FALSE;
+        events_reset(&play_events);
+#ifndef STAGGERED_STEP
+        step_begun = step_cell = 0;
+#endif
         
         for(h = 0; h < HOUSE_COUNT; h++) {
             for(x = 0; x < 24; x++) {
                 //TODO: use memcpy?
                 house_data[h][x] = start_house_data[x];
-                old_house_data[h][x] = start_house_data[x];
             }
             houses[h].alive = TRUE;
             houses[h].x = HOUSE_START_X + (HOUSE_WIDTH + HOUSE_PADDING_X) * h;
@@ -1063,44 +1858,21 @@ int main() {
         
         has_monsters = 1;
         cannon = last_cannon = start_cannon;
-        leftmost = left_o = last_left_o = MONSTER_PADDING_X;
-        rightmost = MONSTERS_X*(MONSTER_WIDTH+MONSTER_PADDING_X);
-        topmost = top_o = last_top_o = MONSTER_TOP;
-        bottommost = MONSTERS_Y*(MONSTER_HEIGHT+MONSTER_PADDING_Y)+MONSTER_TOP-MONSTER_PADDING_Y;
+        last_cannon.alive = FALSE;
         lives = 3;
         score = 0;
-        draw_lives();
+        hud_reset();
+        draw_hud();
         LED_ON;
         sei();
-        while(lives && has_monsters);
+        //The game, then how it ended, until back to the home screen
+        while(game_state != STATE_HOME)
+            sched_run();
         cli();
         LED_OFF;
-        if(!lives) {
-            life_lost_sequence();
-            clear_screen();
-            display_string_xy("Game Over (press center to play again)", 20, 150);
-            PORTB |= _BV(PB6);
-            while(!get_switch_short(_BV(SWC))) {
-                if(PINB % _BV(PB6))
-                    LED_ON;
-                else
-                    LED_OFF;
-                scan_switches();
-            }
-        } else {
-            display_string_xy("YOU WIN!", 130, 150); 
-            _delay_ms(300);
-            if(is_high_score(score)) {
-                clear_screen();
-                game_state = STATE_NEW_HIGH_SCORE;
-                is_drawn = FALSE;
-                init_keyboard();
-                sei();
-                while(game_state == STATE_NEW_HIGH_SCORE);
-                cli();
-                save_high_score(score, k_str);
-                store_high_scores();
-            }
+        if(lives && is_high_score(score)) { //Won, and the name is in
+            save_high_score(score, k_str);
+            store_high_scores();
         }
         reset_sprites();
     } while(1);
@@ -0,0 +1,64 @@
+/*
+  events.h
+  Render events for AVR90USB1286
+  A lock-free single producer, single consumer ring: the game logic
+  (Timer 1 interrupt) pushes what changed, the drawing (tearing
+  interrupt) pops it in the same order. Each side only writes its own
+  index and an index is a single byte, so no locking is needed.
+*/
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <stdint.h>
+
+#define EVENTS_SIZE         32  //Power of 2, at most 128
+
+//What an event means is up to the game, a and b are its arguments.
+typedef struct {
+    uint8_t type;
+    uint8_t a, b;
+} render_event;
+
+//head and tail run freely, head - tail events are waiting.
+typedef struct {
+    render_event buf[EVENTS_SIZE];
+    volatile uint8_t head;  //Written by the producer only
+    volatile uint8_t tail;  //Written by the consumer only
+} event_ring;
+
+static inline void events_reset(event_ring *r) {
+    r->head = r->tail = 0;
+}
+
+static inline uint8_t events_count(event_ring *r) {
+    return (uint8_t)(r->head - r->tail);
+}
+
+static inline uint8_t events_free(event_ring *r) {
+    return EVENTS_SIZE - events_count(r);
+}
+
+/*
+  Producer side. Check events_free() first: an event pushed into a
+  full ring overwrites the oldest one.
+*/
+static inline void events_push(event_ring *r, uint8_t type, uint8_t a, uint8_t b) {
+    render_event *e = &r->buf[r->head & (EVENTS_SIZE - 1)];
+    e->type = type;
+    e->a = a;
+    e->b = b;
+    asm volatile("" ::: "memory"); //The event is written before it is published
+    r->head++;
+}
+
+//Consumer side: the i-th waiting event, i < events_count().
+static inline render_event *events_peek(event_ring *r, uint8_t i) {
+    return &r->buf[(uint8_t)(r->tail + i) & (EVENTS_SIZE - 1)];
+}
+
+static inline void events_pop(event_ring *r) {
+    asm volatile("" ::: "memory"); //The event is read before its slot is freed
+    r->tail++;
+}
+
+#endif /* EVENTS_H */
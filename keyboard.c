@@ -117,7 +117,7 @@ uint8_t move_keyboard() {
 
 void draw_square(uint16_t x, uint16_t y, char data, uint16_t col) {
     //Fill background
-    fill_rectangle_c(x + SQUARE_OFFSET, y + SQUARE_OFFSET, K_GRID_SIZE - SQUARE_OFFSET, K_GRID_SIZE - SQUARE_OFFSET, col);
+    fill_rectangle_c(x + SQUARE_OFFSET, y + SQUARE_OFFSET, K_GRID_SIZE - SQUARE_OFFSET + 1, K_GRID_SIZE - SQUARE_OFFSET + 1, col);
     if(data == 0x8) { //Backspace
         uint8_t off = TEXT_OFFSET_X(2 * (CHAR_WIDTH + 1)) + x + SQUARE_OFFSET;
         display_char_xy_col('<', off, y + SQUARE_OFFSET + TEXT_OFFSET_Y, WHITE, col);
@@ -199,7 +199,7 @@ void draw_keyboard() {
         last_sel = sel;
     }
     if(string_pos < last_string_pos) {
-        fill_rectangle_c(RES_STRING_X,RES_STRING_Y,MAX_STRING_SIZE * (CHAR_WIDTH + 2),CHAR_HEIGHT, display.background);
+        fill_rectangle_c(RES_STRING_X,RES_STRING_Y,MAX_STRING_SIZE * (CHAR_WIDTH + 2),CHAR_HEIGHT + 1, display.background);
     }
     if(string_pos != last_string_pos) {
         display_string_xy_col(k_str, RES_STRING_X, RES_STRING_Y, WHITE);
@@ -7,13 +7,106 @@
 #define BLC			4
 #define RESET		7
 
+#ifndef CMD_ADDR
 #define CMD_ADDR  0x4000
 #define DATA_ADDR 0x4100
+#endif
 
-#define write_cmd(cmd)				asm volatile("sts %0,%1" :: "i" (CMD_ADDR), "r" (cmd) : "memory");
-#define write_data(data)			asm volatile("sts %0,%1" :: "i" (DATA_ADDR), "r" (data) : "memory");
-#define write_data16(data)			asm volatile("sts %0,%B1 \n\t sts %0,%A1" :: "i" (DATA_ADDR), "r" (data)  : "memory");
-#define write_cmd_data(cmd, data)	asm volatile("sts %0,%1 \n\t sts %2,%3" :: "i" (CMD_ADDR), "r" (cmd), "i" (DATA_ADDR), "r" (data)  : "memory");
+/* Bus traffic counters, see lcd_bus_stats in lcd.h */
+#ifdef LCD_STATS
+#include "lcd.h"
+#define LCD_COUNT(field, n)			lcd_bus->field += (n);
+#else
+#define LCD_COUNT(field, n)
+#endif
+
+#define write_cmd(cmd)				{ LCD_COUNT(commands, 1) asm volatile("sts %0,%1" :: "i" (CMD_ADDR), "r" (cmd) : "memory"); }
+#define write_data(data)			{ LCD_COUNT(bytes, 1) asm volatile("sts %0,%1" :: "i" (DATA_ADDR), "r" (data) : "memory"); }
+#define write_data16(data)			{ LCD_COUNT(bytes, 2) asm volatile("sts %0,%B1 \n\t sts %0,%A1" :: "i" (DATA_ADDR), "r" (data)  : "memory"); }
+#define write_cmd_data(cmd, data)	{ LCD_COUNT(commands, 1) LCD_COUNT(bytes, 1) asm volatile("sts %0,%1 \n\t sts %2,%3" :: "i" (CMD_ADDR), "r" (cmd), "i" (DATA_ADDR), "r" (data)  : "memory"); }
+#define read_data(data)				{ LCD_COUNT(bytes, 1) asm volatile("lds %0,%1" : "=r" (data) : "i" (DATA_ADDR) : "memory"); }
+
+/*  Streaming kernels: n1 single pixels, then n8 (n4 for the doubled
+    blit) unrolled groups. Colours are sent high byte first, words in
+    flash are read low byte first with LPM Z+.
+*/
+#define STREAM_FILL_PIXEL	"sts %[data],%B[col] \n\t sts %[data],%A[col] \n\t"
+#define STREAM_PGM_READ		"lpm %[lo],Z+ \n\t lpm %[hi],Z+ \n\t"
+#define STREAM_PGM_WRITE	"sts %[data],%[hi] \n\t sts %[data],%[lo] \n\t"
+
+/* Send col n1 + 8*n8 times, the colour stays in registers. */
+static inline __attribute__((always_inline))
+void stream_fill(uint16_t col, uint8_t n1, uint16_t n8) {
+	LCD_COUNT(bytes, 2 * (n1 + 8UL * n8))
+	asm volatile(
+		"	tst %[n1]		\n\t"
+		"	breq 2f			\n\t"
+		"1:	" STREAM_FILL_PIXEL
+		"	dec %[n1]		\n\t"
+		"	brne 1b			\n\t"
+		"2:	sbiw %[n8],0	\n\t"
+		"	breq 4f			\n\t"
+		"3:	" STREAM_FILL_PIXEL STREAM_FILL_PIXEL STREAM_FILL_PIXEL STREAM_FILL_PIXEL
+		STREAM_FILL_PIXEL STREAM_FILL_PIXEL STREAM_FILL_PIXEL STREAM_FILL_PIXEL
+		"	sbiw %[n8],1	\n\t"
+		"	brne 3b			\n\t"
+		"4:					\n\t"
+		: [n1] "+r" (n1), [n8] "+w" (n8)
+		: [col] "r" (col), [data] "i" (DATA_ADDR)
+		: "memory");
+}
+
+/* Copy n1 + 8*n8 pixels from flash. */
+static inline __attribute__((always_inline))
+void stream_pgm(const uint16_t *src, uint8_t n1, uint16_t n8) {
+	uint8_t lo, hi;
+	LCD_COUNT(bytes, 2 * (n1 + 8UL * n8))
+	asm volatile(
+		"	tst %[n1]		\n\t"
+		"	breq 2f			\n\t"
+		"1:	" STREAM_PGM_READ STREAM_PGM_WRITE
+		"	dec %[n1]		\n\t"
+		"	brne 1b			\n\t"
+		"2:	sbiw %[n8],0	\n\t"
+		"	breq 4f			\n\t"
+		"3:	" STREAM_PGM_READ STREAM_PGM_WRITE STREAM_PGM_READ STREAM_PGM_WRITE
+		STREAM_PGM_READ STREAM_PGM_WRITE STREAM_PGM_READ STREAM_PGM_WRITE
+		STREAM_PGM_READ STREAM_PGM_WRITE STREAM_PGM_READ STREAM_PGM_WRITE
+		STREAM_PGM_READ STREAM_PGM_WRITE STREAM_PGM_READ STREAM_PGM_WRITE
+		"	sbiw %[n8],1	\n\t"
+		"	brne 3b			\n\t"
+		"4:					\n\t"
+		: [lo] "=&r" (lo), [hi] "=&r" (hi), [src] "+z" (src),
+		  [n1] "+r" (n1), [n8] "+w" (n8)
+		: [data] "i" (DATA_ADDR)
+		: "memory");
+}
+
+/* Copy n1 + 4*n4 pixels from flash, each one sent twice. */
+static inline __attribute__((always_inline))
+void stream_pgm_2b(const uint16_t *src, uint8_t n1, uint16_t n4) {
+	uint8_t lo, hi;
+	LCD_COUNT(bytes, 4 * (n1 + 4UL * n4))
+	asm volatile(
+		"	tst %[n1]		\n\t"
+		"	breq 2f			\n\t"
+		"1:	" STREAM_PGM_READ STREAM_PGM_WRITE STREAM_PGM_WRITE
+		"	dec %[n1]		\n\t"
+		"	brne 1b			\n\t"
+		"2:	sbiw %[n4],0	\n\t"
+		"	breq 4f			\n\t"
+		"3:	" STREAM_PGM_READ STREAM_PGM_WRITE STREAM_PGM_WRITE
+		STREAM_PGM_READ STREAM_PGM_WRITE STREAM_PGM_WRITE
+		STREAM_PGM_READ STREAM_PGM_WRITE STREAM_PGM_WRITE
+		STREAM_PGM_READ STREAM_PGM_WRITE STREAM_PGM_WRITE
+		"	sbiw %[n4],1	\n\t"
+		"	brne 3b			\n\t"
+		"4:					\n\t"
+		: [lo] "=&r" (lo), [hi] "=&r" (hi), [src] "+z" (src),
+		  [n1] "+r" (n1), [n4] "+w" (n4)
+		: [data] "i" (DATA_ADDR)
+		: "memory");
+}
   
 /* Basic Commands */
 #define NO_OPERATION								0x00
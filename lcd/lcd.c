@@ -15,6 +15,21 @@
 #include "lcd.h"
 
 lcd display;
+window_stats lcd_window_stats;
+#ifdef LCD_STATS
+bus_stats lcd_bus_stats[LCD_STATS_CATEGORIES];
+bus_stats *lcd_bus = lcd_bus_stats;
+
+void lcd_stats_reset() {
+    uint8_t i;
+    for(i=0; i<LCD_STATS_CATEGORIES; i++) {
+        lcd_bus_stats[i].commands = 0;
+        lcd_bus_stats[i].bytes = 0;
+        lcd_bus_stats[i].windows = 0;
+        lcd_bus_stats[i].pixels = 0;
+    }
+}
+#endif
 static inline uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
 
 void init_lcd() {
@@ -42,6 +57,7 @@ void init_lcd() {
         write_data16(0x0000);
     write_cmd_data(PIXEL_FORMAT_SET, 0x55);     /* 16bit/pixel */
     set_orientation(West);
+    scroll_reset();
     clear_screen();
     display.x = 0;
     display.y = 0;
@@ -90,9 +106,26 @@ void set_orientation(orientation o) {
     write_cmd(PAGE_ADDRESS_SET);
     write_data16(0);
     write_data16(display.height-1);
+    display.win_left = 0;
+    display.win_right = display.width-1;
+    display.win_top = 0;
+    display.win_next = WIN_INVALID;
+    clip_reset();
 }
 
-void set_frame_rate_hz(uint8_t f) {
+/*  Drawing primitives only touch pixels inside r. Whatever the display
+    list holds is sent first, with the clip it was recorded under. */
+void set_clip(rectangle r) {
+    dl_flush();
+    display.clip = r;
+}
+
+void clip_reset() {
+    rectangle r = {0, display.width-1, 0, display.height-1};
+    set_clip(r);
+}
+
+static void frame_rate(uint8_t cmd, uint8_t f) {
     uint8_t diva, rtna, period;
     if (f>118)
         f = 118;
@@ -112,71 +145,196 @@ void set_frame_rate_hz(uint8_t f) {
     /*   See ILI9341 datasheet, page 155  */
     period = 1920.0/f;
     rtna = period >> diva;
-    write_cmd(FRAME_CONTROL_IN_NORMAL_MODE);
+    write_cmd(cmd);
     write_data(diva);
     write_data(rtna);
+    display.win_next = WIN_INVALID;
 }
 
-void fill_image_pgm(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col) {
-    write_cmd(COLUMN_ADDRESS_SET);
-    write_data16(x);
-    write_data16(x+width);
-    write_cmd(PAGE_ADDRESS_SET);
-    write_data16(y);
-    write_data16(y+height);
-    write_cmd(MEMORY_WRITE);
-/*  uint16_t x, y;
-    for(x=r.left; x<=r.right; x++)
-        for(y=r.top; y<=r.bottom; y++)
-            write_data16(col);
+void set_frame_rate_hz(uint8_t f) {
+    frame_rate(FRAME_CONTROL_IN_NORMAL_MODE, f);
+}
+
+/*  Frame rate used in idle and in partial mode. */
+void set_idle_frame_rate_hz(uint8_t f) {
+    frame_rate(FRAME_CONTROL_IN_IDLE_MODE, f);
+    frame_rate(FRAME_CONTROL_IN_PARTIAL_MODE, f);
+}
+
+/*  Panel lines run against the screen axis in West and South. */
+static uint8_t lines_reversed() {
+    return display.orient == West || display.orient == South;
+}
+
+/*  Partial mode only drives the band first..last of the panel, given
+    along the same axis as scrolling (see below). The rest is blank. */
+void set_partial_area(uint16_t first, uint16_t last) {
+    write_cmd(PARTIAL_AREA);
+    write_data16(lines_reversed() ? LCDHEIGHT-1 - last : first);
+    write_data16(lines_reversed() ? LCDHEIGHT-1 - first : last);
+    display.win_next = WIN_INVALID;
+}
+
+void partial_mode(uint8_t on) {
+    write_cmd(on ? PARTIAL_MODE_ON : NORMAL_DISPLAY_MODE_ON);
+    display.win_next = WIN_INVALID;
+}
+
+/*  Idle mode shows 8 colours, the top bit of each component. */
+void idle_mode(uint8_t on) {
+    write_cmd(on ? IDLE_MODE_ON : IDLE_MODE_OFF);
+    display.win_next = WIN_INVALID;
+}
+
+/*  Hardware scrolling. The controller scrolls along the 320 lines of
+    the panel: screen x in West/East, screen y in North/South.
 */
-    uint16_t wpixels = width + 1;
-    uint16_t hpixels = height + 1;
-    uint8_t mod8, div8;
-    uint16_t odm8, odd8;
-    if (hpixels > wpixels) {
-        mod8 = hpixels & 0x07;
-        div8 = hpixels >> 3;
-        odm8 = wpixels*mod8;
-        odd8 = wpixels*div8;
+static uint16_t scroll_top, scroll_size;
+
+/*  Scroll the band first..last (screen coordinates along the scroll
+    axis), the rest of the screen stays where it is. */
+void set_scroll_area(uint16_t first, uint16_t last) {
+    scroll_top = lines_reversed() ? LCDHEIGHT-1 - last : first;
+    scroll_size = last - first + 1;
+    write_cmd(VERTICAL_SCROLLING_DEFINITION);
+    write_data16(scroll_top);
+    write_data16(scroll_size);
+    write_data16(LCDHEIGHT - scroll_top - scroll_size);
+    set_scroll_offset(0);
+}
+
+/*  Show the band moved back by n pixels: what was drawn at first+n
+    is now seen at first, what was drawn at first is seen at first+size-n.
+    Drawing still addresses the memory, not the screen. */
+void set_scroll_offset(uint16_t n) {
+    n %= scroll_size;
+    if (lines_reversed() && n)
+        n = scroll_size - n;
+    write_cmd(VERTICAL_SCROLLING_START_ADDRESS);
+    write_data16(scroll_top + n);
+    display.win_next = WIN_INVALID;
+}
+
+/*  Back to a still screen. */
+void scroll_reset() {
+    set_scroll_area(0, LCDHEIGHT-1);
+}
+
+/*  Open the window left..right, top..bottom for a memory write.
+    The controller's window is shadowed in display: an axis is only sent
+    when it changed, and the page window always extends to the bottom of
+    the screen so that it changes whenever the top does and no more.
+    Callers write exactly (right-left+1)*(bottom-top+1) pixels, so when
+    a window continues the previous one (same columns, starting on the
+    row where the last write stopped) no address is sent at all.
+*/
+static void set_window_axes(uint16_t left, uint16_t right, uint16_t top) {
+    if (left != display.win_left || right != display.win_right) {
+        write_cmd(COLUMN_ADDRESS_SET);
+        write_data16(left);
+        write_data16(right);
+        display.win_left = left;
+        display.win_right = right;
+        lcd_window_stats.sent += 5;
     } else {
-        mod8 = wpixels & 0x07;
-        div8 = wpixels >> 3;
-        odm8 = hpixels*mod8;
-        odd8 = hpixels*div8;
+        lcd_window_stats.saved += 5;
     }
-    uint8_t pix1 = odm8 & 0x07;
-    while(pix1--)
-        write_data16(pgm_read_word(col++));
+    if (top != display.win_top) {
+        write_cmd(PAGE_ADDRESS_SET);
+        write_data16(top);
+        write_data16(display.height-1);
+        display.win_top = top;
+        lcd_window_stats.sent += 5;
+    } else {
+        lcd_window_stats.saved += 5;
+    }
+}
 
-    uint16_t pix8 = odd8 + (odm8 >> 3);
-    while(pix8--) {
-        write_data16(pgm_read_word(col++));
-        write_data16(pgm_read_word(col++));
-        write_data16(pgm_read_word(col++));
-        write_data16(pgm_read_word(col++));
-        write_data16(pgm_read_word(col++));
-        write_data16(pgm_read_word(col++));
-        write_data16(pgm_read_word(col++));
-        write_data16(pgm_read_word(col++));
+static void set_window(uint16_t left, uint16_t right, uint16_t top, uint16_t bottom) {
+#ifdef LCD_STATS
+    lcd_bus->windows++;
+    lcd_bus->pixels += (uint32_t)(right - left + 1) * (bottom - top + 1);
+#endif
+    if (left == display.win_left && right == display.win_right
+            && top == display.win_next) {
+        write_cmd(WRITE_MEMORY_CONTINUE);
+        lcd_window_stats.saved += 10;
+    } else {
+        set_window_axes(left, right, top);
+        write_cmd(MEMORY_WRITE);
     }
+    display.win_next = bottom < display.height-1 ? bottom+1 : WIN_INVALID;
 }
 
-void fill_image_pgm_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col) {
-    write_cmd(COLUMN_ADDRESS_SET);
-    write_data16(x);
-    write_data16(x+width-1);
-    write_cmd(PAGE_ADDRESS_SET);
-    write_data16(y);
-    write_data16(y+height-1);
-    write_cmd(MEMORY_WRITE);
-/*  uint16_t x, y;
-    for(x=r.left; x<=r.right; x++)
-        for(y=r.top; y<=r.bottom; y++)
-            write_data16(col);
+/*  Read r back from the controller into buf, row by row. After a dummy
+    byte every pixel comes as three bytes, red, green and blue, with the
+    colour in the top bits whatever the pixel format written.
 */
-    uint16_t wpixels = width;
-    uint16_t hpixels = height;
+void read_rectangle(rectangle r, uint16_t *buf) {
+    uint16_t n = (r.right - r.left + 1) * (r.bottom - r.top + 1);
+    uint8_t red, green, blue;
+    set_window_axes(r.left, r.right, r.top);
+    write_cmd(MEMORY_READ);
+    read_data(red);
+    while(n--) {
+        read_data(red);
+        read_data(green);
+        read_data(blue);
+        *buf++ = color565(red, green, blue);
+    }
+    display.win_next = WIN_INVALID;
+}
+
+/*  Save-under. The display list is flushed first so that the saved
+    pixels are those on screen, and restoring is not deferred either:
+    the buffer can be reused straight away.
+*/
+void save_under_area(save_under *s, rectangle r) {
+    dl_flush();
+    read_rectangle(r, s->buf);
+    s->r = r;
+    s->saved = 1;
+}
+
+void restore_under(save_under *s) {
+    if (!s->saved)
+        return;
+    dl_flush();
+    fill_image(s->r.left, s->r.top, s->r.right - s->r.left + 1,
+               s->r.bottom - s->r.top + 1, s->buf);
+    s->saved = 0;
+}
+
+/*  Clip the width by height area at x, y to display.clip. Coordinates
+    are taken as signed, so an area may start off the left or the top
+    of the screen. Returns 0 when nothing is left to draw, otherwise
+    the visible part is in r.
+*/
+static uint8_t clip(uint16_t x, uint16_t y, uint16_t width, uint16_t height, rectangle *r) {
+    int16_t left = x, top = y;
+    int16_t right = left + width - 1, bottom = top + height - 1;
+    if (!width || !height)
+        return 0;
+    if (left < (int16_t)display.clip.left)
+        left = display.clip.left;
+    if (right > (int16_t)display.clip.right)
+        right = display.clip.right;
+    if (top < (int16_t)display.clip.top)
+        top = display.clip.top;
+    if (bottom > (int16_t)display.clip.bottom)
+        bottom = display.clip.bottom;
+    if (left > right || top > bottom)
+        return 0;
+    r->left = left;
+    r->right = right;
+    r->top = top;
+    r->bottom = bottom;
+    return 1;
+}
+
+/*  Split width*height pixels into n1 + 8*n8 for the streaming kernels,
+    without overflowing 16 bits on a whole screen. */
+static void count8(uint16_t wpixels, uint16_t hpixels, uint8_t *n1, uint16_t *n8) {
     uint8_t mod8, div8;
     uint16_t odm8, odd8;
     if (hpixels > wpixels) {
@@ -190,178 +348,755 @@ void fill_image_pgm_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
         odm8 = hpixels*mod8;
         odd8 = hpixels*div8;
     }
-    uint8_t pix1 = odm8 & 0x07;
-    while(pix1--) {
-        write_data16(pgm_read_word(col));
-        write_data16(pgm_read_word(col++));
-    }
-    uint16_t pix8 = odd8 + (odm8 >> 3);
-    uint16_t temp;
-    while(pix8--) {
-        temp = pgm_read_word(col++);
-        write_data16(temp);
-        write_data16(temp);
-        temp = pgm_read_word(col++);
-        write_data16(temp);
-        write_data16(temp);
-        temp = pgm_read_word(col++);
-        write_data16(temp);
-        write_data16(temp);
-        temp = pgm_read_word(col++);
-        write_data16(temp);
-        write_data16(temp);
-    }
+    *n1 = odm8 & 0x07;
+    *n8 = odd8 + (odm8 >> 3);
 }
 
-void fill_image(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col) {
-    write_cmd(COLUMN_ADDRESS_SET);
-    write_data16(x);
-    write_data16(x+width);
-    write_cmd(PAGE_ADDRESS_SET);
-    write_data16(y);
-    write_data16(y+height);
-    write_cmd(MEMORY_WRITE);
+/*  All the primitives below draw exactly width by height pixels, or the
+    rectangle r, clipped to display.clip. Images keep their stride when
+    clipped, only the visible pixels are sent. */
+
+void fill_image_pgm(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col) {
+    rectangle r;
+    uint16_t w, h, dx, dy;
+    uint8_t n1;
+    uint16_t n8;
+    if (!clip(x, y, width, height, &r))
+        return;
+    set_window(r.left, r.right, r.top, r.bottom);
 /*  uint16_t x, y;
     for(x=r.left; x<=r.right; x++)
         for(y=r.top; y<=r.bottom; y++)
             write_data16(col);
 */
-    uint16_t wpixels = width + 1;
-    uint16_t hpixels = height + 1;
-    uint8_t mod8, div8;
-    uint16_t odm8, odd8;
-    if (hpixels > wpixels) {
-        mod8 = hpixels & 0x07;
-        div8 = hpixels >> 3;
-        odm8 = wpixels*mod8;
-        odd8 = wpixels*div8;
-    } else {
-        mod8 = wpixels & 0x07;
-        div8 = wpixels >> 3;
-        odm8 = hpixels*mod8;
-        odd8 = hpixels*div8;
+    w = r.right - r.left + 1;
+    h = r.bottom - r.top + 1;
+    dx = r.left - x;
+    dy = r.top - y;
+    if (w == width) {   /* whole rows, one stream */
+        count8(w, h, &n1, &n8);
+        stream_pgm(col + dy*width, n1, n8);
+        return;
     }
-    uint8_t pix1 = odm8 & 0x07;
-    while(pix1--)
-        write_data16(*col++);
+    col += dy*width + dx;
+    while(h--) {
+        stream_pgm(col, w & 0x07, w >> 3);
+        col += width;
+    }
+}
 
-    uint16_t pix8 = odd8 + (odm8 >> 3);
-    while(pix8--) {
-        write_data16(*col++);
-        write_data16(*col++);
-        write_data16(*col++);
-        write_data16(*col++);
-        write_data16(*col++);
-        write_data16(*col++);
-        write_data16(*col++);
-        write_data16(*col++);
+/*  Send w pixels of a row of a doubled image, starting at screen column
+    dx of the row: an odd start or end sends half a source pixel. */
+static void write_row_pgm_2b(const uint16_t *row, uint16_t dx, uint16_t w) {
+    row += dx >> 1;
+    if (dx & 1) {
+        write_data16(pgm_read_word(row++));
+        w--;
     }
+    stream_pgm_2b(row, (w >> 1) & 0x03, w >> 3);
+    if (w & 1)
+        write_data16(pgm_read_word(row + (w >> 1)));
 }
 
-void fill_rectangle(rectangle r, uint16_t col) {
-    write_cmd(COLUMN_ADDRESS_SET);
-    write_data16(r.left);
-    write_data16(r.right);
-    write_cmd(PAGE_ADDRESS_SET);
-    write_data16(r.top);
-    write_data16(r.bottom);
-    write_cmd(MEMORY_WRITE);
-/*  uint16_t x, y;
-    for(x=r.left; x<=r.right; x++)
-        for(y=r.top; y<=r.bottom; y++)
+void fill_image_pgm_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col) {
+    rectangle r;
+    uint16_t w, h, dx, dy, pixels;
+    if (!clip(x, y, width, height, &r))
+        return;
+    set_window(r.left, r.right, r.top, r.bottom);
+    w = r.right - r.left + 1;
+    h = r.bottom - r.top + 1;
+    dx = r.left - x;
+    dy = r.top - y;
+    col += dy * (width >> 1);
+    if (w == width) {
+        /* each source pixel is sent twice, four source pixels per pass */
+        pixels = (width >> 1) * h;
+        stream_pgm_2b(col, pixels & 0x03, pixels >> 2);
+        return;
+    }
+    while(h--) {
+        write_row_pgm_2b(col, dx, w);
+        col += width >> 1;
+    }
+}
+
+/* Send the same colour n times. */
+static void write_run(uint16_t col, uint16_t n) {
+    stream_fill(col, n & 0x07, n >> 3);
+}
+
+/*  Stream a run-length encoded image, see tools/spritec.py for
+    the format. Each run costs one read from flash however long it is.
+    Every pixel of the image is sent (1 << shift) times.
+*/
+static void write_rle(const uint8_t *data, uint16_t pixels, uint8_t shift) {
+    uint8_t n;
+    uint16_t col;
+    while(pixels) {
+        n = pgm_read_byte(data++);
+        col = pgm_read_word(data);
+        data += 2;
+        if (n > pixels)
+            n = pixels;
+        write_run(col, n << shift);
+        pixels -= n;
+    }
+}
+
+/*  Same for a clipped image of width screen pixels: the runs are walked
+    from the start, only screen columns dx..dx+w-1 of rows dy..dy+h-1
+    are sent. */
+static void write_rle_clipped(const uint8_t *data, uint16_t width, uint8_t shift,
+                              uint16_t dx, uint16_t dy, uint16_t w, uint16_t h) {
+    uint16_t u = 0, v = 0, n, seg, a, b, col;
+    while(v < dy + h) {
+        n = pgm_read_byte(data++) << shift;
+        col = pgm_read_word(data);
+        data += 2;
+        while(n && v < dy + h) {
+            seg = width - u < n ? width - u : n;
+            if (v >= dy) {
+                a = u > dx ? u : dx;
+                b = u + seg < dx + w ? u + seg : dx + w;
+                if (a < b)
+                    write_run(col, b - a);
+            }
+            u += seg;
+            n -= seg;
+            if (u == width) {
+                u = 0;
+                v++;
+            }
+        }
+    }
+}
+
+static void fill_rle(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                     const uint8_t *data, uint8_t shift) {
+    rectangle r;
+    uint16_t w, h;
+    if (!clip(x, y, width, height, &r))
+        return;
+    set_window(r.left, r.right, r.top, r.bottom);
+    w = r.right - r.left + 1;
+    h = r.bottom - r.top + 1;
+    if (w == width && h == height)
+        write_rle(data, (width >> shift) * height, shift);
+    else
+        write_rle_clipped(data, width, shift, r.left - x, r.top - y, w, h);
+}
+
+void fill_image_pgm_rle(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data) {
+    fill_rle(x, y, width, height, data, 0);
+}
+
+void fill_image_pgm_rle_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data) {
+    fill_rle(x, y, width, height, data, 1);
+}
+
+/*  Copy the palette of an indexed image to pal, past the bits per pixel
+    byte at the start of the data. Returns the bits per pixel. */
+static uint8_t load_palette(const uint8_t **data, const uint16_t *palette, uint16_t *pal) {
+    uint8_t bpp, i;
+    bpp = pgm_read_byte((*data)++);
+    for(i=0; i < (1 << bpp); i++)
+        pal[i] = pgm_read_word(palette + i);
+    return bpp;
+}
+
+/* Palette index of pixel px of an indexed image row. */
+static inline uint8_t pixel_index(const uint8_t *row, uint8_t bpp, uint16_t px) {
+    uint16_t bit = px * bpp;
+    return (pgm_read_byte(row + (bit >> 3)) >> (8 - bpp - (bit & 7))) & ((1 << bpp) - 1);
+}
+
+/*  Stream a palette indexed image, see tools/spritec.py for the format.
+    The palette is copied to RAM first, then each byte read from flash
+    gives 8, 4 or 2 pixels. Every pixel is sent xs times and every row
+    ys times: a row is replayed from its few packed bytes, not from
+    the colours.
+*/
+static void write_indexed(const uint8_t *data, uint16_t width, uint16_t height,
+                          const uint16_t *palette, uint8_t xs, uint8_t ys) {
+    uint16_t pal[16];
+    uint16_t w, col;
+    const uint8_t *row;
+    uint8_t bpp, ppb, n, i, j, bits, index, rep;
+    bpp = load_palette(&data, palette, pal);
+    ppb = 8 / bpp;
+    while(height--) {
+        for(rep=ys, row=data; rep; rep--) {
+            data = row;
+            for(w=width; w; w-=n) {
+                bits = pgm_read_byte(data++);
+                n = w < ppb ? w : ppb;
+                for(i=n; i; i--) {
+                    if (bpp == 1) {
+                        index = bits >> 7;
+                        bits <<= 1;
+                    } else if (bpp == 2) {
+                        index = bits >> 6;
+                        bits <<= 2;
+                    } else {
+                        index = bits >> 4;
+                        bits <<= 4;
+                    }
+                    col = pal[index];
+                    for(j=xs; j; j--)
+                        write_data16(col);
+                }
+            }
+        }
+    }
+}
+
+/*  Colour of stored pixel px of a row of a width pixels wide image,
+    index 0 outside it (row is NULL outside the image). */
+static inline uint16_t pixel_colour(const uint8_t *row, uint8_t bpp, const uint16_t *pal,
+                                    int16_t px, uint16_t width) {
+    if (!row || px < 0 || px >= (int16_t)width)
+        return pal[0];
+    return pal[pixel_index(row, bpp, px)];
+}
+
+/*  Send w by h screen pixels of a scaled indexed image (data past the
+    bits per pixel byte), starting ph pixels into stored pixel px0 and
+    rph rows into stored row py. Stored pixels are stepped through, the
+    only divisions are the caller's, for a clipped start. */
+static void write_indexed_area(const uint8_t *data, uint8_t bpp, const uint16_t *pal,
+                               uint16_t width, uint16_t height, uint8_t xs, uint8_t ys,
+                               int16_t px0, uint8_t ph0, int16_t py, uint8_t rph,
+                               uint16_t w, uint16_t h) {
+    uint16_t stride = (width * bpp + 7) >> 3;
+    const uint8_t *row;
+    uint16_t u, col;
+    int16_t px;
+    uint8_t ph;
+    while(h--) {
+        row = py >= 0 && py < (int16_t)height ? data + py*stride : NULL;
+        px = px0;
+        ph = ph0;
+        col = pixel_colour(row, bpp, pal, px, width);
+        for(u=w; u; u--) {
             write_data16(col);
+            if (++ph == xs) {
+                ph = 0;
+                col = pixel_colour(row, bpp, pal, ++px, width);
+            }
+        }
+        if (++rph == ys) {
+            rph = 0;
+            py++;
+        }
+    }
+}
+
+static void fill_indexed(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                         const uint8_t *data, const uint16_t *palette, uint8_t xs, uint8_t ys) {
+    uint16_t pal[16];
+    rectangle r;
+    uint16_t w, h, dx, dy;
+    uint8_t bpp;
+    if (!clip(x, y, width, height, &r))
+        return;
+    set_window(r.left, r.right, r.top, r.bottom);
+    w = r.right - r.left + 1;
+    h = r.bottom - r.top + 1;
+    if (w == width && h == height) {
+        write_indexed(data, width / xs, height / ys, palette, xs, ys);
+        return;
+    }
+    dx = r.left - x;
+    dy = r.top - y;
+    bpp = load_palette(&data, palette, pal);
+    write_indexed_area(data, bpp, pal, width / xs, height / ys, xs, ys,
+                       dx / xs, dx % xs, dy / ys, dy % ys, w, h);
+}
+
+void fill_image_pgm_indexed(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                            const uint8_t *data, const uint16_t *palette) {
+    fill_indexed(x, y, width, height, data, palette, 1, 1);
+}
+
+void fill_image_pgm_indexed_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                               const uint8_t *data, const uint16_t *palette) {
+    fill_indexed(x, y, width, height, data, palette, 2, 1);
+}
+
+/*  An indexed image stored at width/xs by height/ys, every pixel drawn
+    as an xs by ys block. */
+void fill_image_pgm_indexed_scaled(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                   const uint8_t *data, const uint16_t *palette,
+                                   uint8_t xs, uint8_t ys) {
+    fill_indexed(x, y, width, height, data, palette, xs, ys);
+}
+
+/* count, w, h, xs, ys, bx, by, bw, bh, pixels lo, hi */
+#define SPANS_HEADER    11
+
+/*  Send the spans of a span table, see tools/spritec.py for the format
+    (deltas and opaque spans). x, y is the position of the sprite drawn,
+    data and palette its indexed image, drawn at the scale of the table.
+    Without data every pixel of the spans gets col.
 */
-    uint16_t wpixels = r.right - r.left + 1;
-    uint16_t hpixels = r.bottom - r.top + 1;
-    uint8_t mod8, div8;
-    uint16_t odm8, odd8;
-    if (hpixels > wpixels) {
-        mod8 = hpixels & 0x07;
-        div8 = hpixels >> 3;
-        odm8 = wpixels*mod8;
-        odd8 = wpixels*div8;
-    } else {
-        mod8 = wpixels & 0x07;
-        div8 = wpixels >> 3;
-        odm8 = hpixels*mod8;
-        odd8 = hpixels*div8;
+static void write_spans(uint16_t x, uint16_t y, const uint8_t *spans,
+                        const uint8_t *data, const uint16_t *palette, uint16_t col) {
+    uint16_t pal[16];
+    uint8_t bpp = 0, width, height, xs, ys, n;
+    int8_t sx, sy;
+    int16_t px, py;
+    uint16_t u, v, du, dv, n8;
+    uint8_t n1;
+    rectangle r;
+    if (data)
+        bpp = load_palette(&data, palette, pal);
+    n = pgm_read_byte(spans);
+    width = pgm_read_byte(spans + 1);
+    height = pgm_read_byte(spans + 2);
+    xs = pgm_read_byte(spans + 3);
+    ys = pgm_read_byte(spans + 4);
+    spans += SPANS_HEADER;
+    while(n--) {
+        sx = pgm_read_byte(spans++);
+        sy = pgm_read_byte(spans++);
+        u = pgm_read_byte(spans++);
+        v = pgm_read_byte(spans++);
+        if (!clip(x + xs*sx, y + ys*sy, xs*u, ys*v, &r))
+            continue;
+        set_window(r.left, r.right, r.top, r.bottom);
+        u = r.right - r.left + 1;
+        v = r.bottom - r.top + 1;
+        if (!data) {
+            count8(u, v, &n1, &n8);
+            stream_fill(col, n1, n8);
+            continue;
+        }
+        px = sx;
+        py = sy;
+        du = r.left - (x + xs*sx);
+        dv = r.top - (y + ys*sy);
+        if (du) {
+            px += du / xs;
+            du %= xs;
+        }
+        if (dv) {
+            py += dv / ys;
+            dv %= ys;
+        }
+        write_indexed_area(data, bpp, pal, width, height, xs, ys, px, du, py, dv, u, v);
     }
-    uint8_t pix1 = odm8 & 0x07;
-    while(pix1--)
-        write_data16(col);
+}
+
+/*  Draw an indexed sprite through a span table, which also gives its
+    size and scale: a delta replaces the sprite it was made from, an
+    opaque span table draws the sprite with its background transparent.
+*/
+void fill_image_pgm_spans(uint16_t x, uint16_t y, const uint8_t *spans,
+                          const uint8_t *data, const uint16_t *palette) {
+    write_spans(x, y, spans, data, palette, 0);
+}
+
+/* Paint the spans in one colour, e.g. to erase a sprite drawn through them. */
+void fill_spans(uint16_t x, uint16_t y, const uint8_t *spans, uint16_t col) {
+    write_spans(x, y, spans, NULL, NULL, col);
+}
 
-    uint16_t pix8 = odd8 + (odm8 >> 3);
-    while(pix8--) {
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
+/* Image in RAM. */
+void fill_image(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col) {
+    rectangle r;
+    uint16_t w, h, dx, dy, n;
+    if (!clip(x, y, width, height, &r))
+        return;
+    set_window(r.left, r.right, r.top, r.bottom);
+    w = r.right - r.left + 1;
+    h = r.bottom - r.top + 1;
+    dx = r.left - x;
+    dy = r.top - y;
+    col += dy*width + dx;
+    while(h--) {
+        for(n=w; n>=8; n-=8) {
+            write_data16(*col++);
+            write_data16(*col++);
+            write_data16(*col++);
+            write_data16(*col++);
+            write_data16(*col++);
+            write_data16(*col++);
+            write_data16(*col++);
+            write_data16(*col++);
+        }
+        while(n--)
+            write_data16(*col++);
+        col += width - w;
     }
 }
 
+void fill_rectangle(rectangle r, uint16_t col) {
+    fill_rectangle_c(r.left, r.top, r.right - r.left + 1, r.bottom - r.top + 1, col);
+}
+
 void fill_rectangle_c(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t col) {
-    write_cmd(COLUMN_ADDRESS_SET);
-    write_data16(x);
-    write_data16(x+width);
-    write_cmd(PAGE_ADDRESS_SET);
-    write_data16(y);
-    write_data16(y+height);
-    write_cmd(MEMORY_WRITE);
+    rectangle r;
+    uint8_t n1;
+    uint16_t n8;
+    if (!clip(x, y, width, height, &r))
+        return;
+    set_window(r.left, r.right, r.top, r.bottom);
 /*  uint16_t x, y;
     for(x=r.left; x<=r.right; x++)
         for(y=r.top; y<=r.bottom; y++)
             write_data16(col);
 */
-    uint16_t wpixels = width + 1;
-    uint16_t hpixels = height + 1;
-    uint8_t mod8, div8;
-    uint16_t odm8, odd8;
-    if (hpixels > wpixels) {
-        mod8 = hpixels & 0x07;
-        div8 = hpixels >> 3;
-        odm8 = wpixels*mod8;
-        odd8 = wpixels*div8;
-    } else {
-        mod8 = wpixels & 0x07;
-        div8 = wpixels >> 3;
-        odm8 = hpixels*mod8;
-        odd8 = hpixels*div8;
-    }
-    uint8_t pix1 = odm8 & 0x07;
-    while(pix1--)
-        write_data16(col);
-
-    uint16_t pix8 = odd8 + (odm8 >> 3);
-    while(pix8--) {
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-        write_data16(col);
-    }
+    count8(r.right - r.left + 1, r.bottom - r.top + 1, &n1, &n8);
+    stream_fill(col, n1, n8);
 }
 
 void fill_rectangle_indexed(rectangle r, uint16_t* col) {
     uint16_t x, y;
-    write_cmd(COLUMN_ADDRESS_SET);
-    write_data16(r.left);
-    write_data16(r.right);
-    write_cmd(PAGE_ADDRESS_SET);
-    write_data16(r.top);
-    write_data16(r.bottom);
-    write_cmd(MEMORY_WRITE);
+    set_window(r.left, r.right, r.top, r.bottom);
     for(x=r.left; x<=r.right; x++)
         for(y=r.top; y<=r.bottom; y++)
             write_data16(*col++);
 }
 
+/*  Display list.
+    Drawing operations of a frame are collected here instead of being
+    sent to the controller straight away. While recording, fills and
+    images that are completely painted over by a later opaque operation
+    are dropped, fills partially covered along a whole edge are trimmed
+    and fills of the same colour are merged when their union is a
+    rectangle. dl_flush() then sends what is left, in recording order.
+*/
+#define DL_FILL         0
+#define DL_IMAGE_PGM    1
+#define DL_IMAGE_PGM_2B 2
+#define DL_IMAGE_RLE    3
+#define DL_IMAGE_RLE_2B 4
+#define DL_IMAGE_IDX    5
+#define DL_SPANS        6
+#define DL_SPANS_FILL   7
+
+typedef struct {
+    rectangle r;
+    uint8_t op;
+    uint8_t scale;      /* xs << 4 | ys of scaled indexed images and spans */
+#ifdef LCD_STATS
+    uint8_t category;   /* counted as when it was recorded */
+#endif
+    union {
+        uint16_t col;
+        uint16_t *img;
+        const uint8_t *rle;
+        struct {
+            const uint8_t *data;
+            const uint16_t *palette;
+            const uint8_t *spans;
+        } idx;
+        struct {
+            const uint8_t *spans;
+            uint16_t col;
+        } mask;
+    } arg;
+} dl_op;
+
+static dl_op dl_ops[DL_SIZE];
+static uint8_t dl_count;
+static uint32_t dl_requested, dl_sent;
+dl_stats display_list_stats;
+
+static inline uint32_t rect_area(rectangle *r) {
+    return (uint32_t)(r->right - r->left + 1) * (r->bottom - r->top + 1);
+}
+
+static inline uint8_t rect_intersects(rectangle *a, rectangle *b) {
+    return !(a->left > b->right || a->right < b->left
+          || a->top > b->bottom || a->bottom < b->top);
+}
+
+static inline uint8_t rect_contains(rectangle *outer, rectangle *inner) {
+    return outer->left <= inner->left && outer->right >= inner->right
+        && outer->top <= inner->top && outer->bottom >= inner->bottom;
+}
+
+/* Grow a to a|b if the union is itself a rectangle. */
+static uint8_t rect_merge(rectangle *a, rectangle *b) {
+    if (rect_contains(a, b))
+        return 1;
+    if (a->top == b->top && a->bottom == b->bottom
+            && b->left <= a->right + 1 && b->right + 1 >= a->left) {
+        if (b->left < a->left) a->left = b->left;
+        if (b->right > a->right) a->right = b->right;
+        return 1;
+    }
+    if (a->left == b->left && a->right == b->right
+            && b->top <= a->bottom + 1 && b->bottom + 1 >= a->top) {
+        if (b->top < a->top) a->top = b->top;
+        if (b->bottom > a->bottom) a->bottom = b->bottom;
+        return 1;
+    }
+    return 0;
+}
+
+/* r is about to be painted opaquely: remove whatever it hides. */
+static void dl_cover(rectangle *r) {
+    uint8_t i, j;
+    for(i=0, j=0; i<dl_count; i++) {
+        rectangle *o = &dl_ops[i].r;
+        if (rect_contains(r, o))
+            continue;
+        if (dl_ops[i].op == DL_FILL && rect_intersects(r, o)) {
+            if (r->top <= o->top && r->bottom >= o->bottom) {
+                if (r->left <= o->left)
+                    o->left = r->right + 1;
+                else if (r->right >= o->right)
+                    o->right = r->left - 1;
+            } else if (r->left <= o->left && r->right >= o->right) {
+                if (r->top <= o->top)
+                    o->top = r->bottom + 1;
+                else if (r->bottom >= o->bottom)
+                    o->bottom = r->top - 1;
+            }
+        }
+        if (i != j)
+            dl_ops[j] = dl_ops[i];
+        j++;
+    }
+    dl_count = j;
+}
+
+static dl_op *dl_push(rectangle *r, uint8_t op) {
+    if (dl_count == DL_SIZE)
+        dl_flush();
+    dl_ops[dl_count].r = *r;
+    dl_ops[dl_count].op = op;
+#ifdef LCD_STATS
+    dl_ops[dl_count].category = lcd_bus - lcd_bus_stats;
+#endif
+    return &dl_ops[dl_count++];
+}
+
+/* Record an opaque image covering r. */
+static dl_op *dl_image(rectangle *r, uint8_t op) {
+    dl_requested += rect_area(r);
+    dl_cover(r);
+    return dl_push(r, op);
+}
+
+void dl_begin() {
+    dl_flush();
+    dl_requested = 0;
+    dl_sent = 0;
+}
+
+/*  Operations reaching past the clip rectangle are not recorded, the
+    list is flushed and they are drawn straight away. This keeps the
+    wrap round of negative coordinates out of the rectangle tests. */
+static uint8_t dl_clipped(rectangle *r) {
+    if (r->left <= r->right && r->top <= r->bottom
+            && rect_contains(&display.clip, r))
+        return 0;
+    dl_flush();
+    return 1;
+}
+
+void dl_fill_rectangle(rectangle r, uint16_t col) {
+    int8_t i;
+    /* a fill needs no origin, it is clipped here */
+    if (!clip(r.left, r.top, r.right - r.left + 1, r.bottom - r.top + 1, &r))
+        return;
+    dl_requested += rect_area(&r);
+    dl_cover(&r);
+    /* Fold into an earlier fill, unless something drawn since overlaps */
+    for(i=dl_count-1; i>=0; i--) {
+        if (dl_ops[i].op == DL_FILL && dl_ops[i].arg.col == col
+                && rect_merge(&dl_ops[i].r, &r))
+            return;
+        if (rect_intersects(&dl_ops[i].r, &r))
+            break;
+    }
+    dl_push(&r, DL_FILL)->arg.col = col;
+}
+
+void dl_fill_rectangle_c(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t col) {
+    rectangle r = {x, x+width-1, y, y+height-1};
+    dl_fill_rectangle(r, col);
+}
+
+void dl_fill_image_pgm(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col) {
+    rectangle r = {x, x+width-1, y, y+height-1};
+    if (dl_clipped(&r))
+        fill_image_pgm(x, y, width, height, col);
+    else
+        dl_image(&r, DL_IMAGE_PGM)->arg.img = col;
+}
+
+void dl_fill_image_pgm_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col) {
+    rectangle r = {x, x+width-1, y, y+height-1};
+    if (dl_clipped(&r))
+        fill_image_pgm_2b(x, y, width, height, col);
+    else
+        dl_image(&r, DL_IMAGE_PGM_2B)->arg.img = col;
+}
+
+void dl_fill_image_pgm_rle(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data) {
+    rectangle r = {x, x+width-1, y, y+height-1};
+    if (dl_clipped(&r))
+        fill_image_pgm_rle(x, y, width, height, data);
+    else
+        dl_image(&r, DL_IMAGE_RLE)->arg.rle = data;
+}
+
+void dl_fill_image_pgm_rle_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data) {
+    rectangle r = {x, x+width-1, y, y+height-1};
+    if (dl_clipped(&r))
+        fill_image_pgm_rle_2b(x, y, width, height, data);
+    else
+        dl_image(&r, DL_IMAGE_RLE_2B)->arg.rle = data;
+}
+
+static void dl_indexed(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                       const uint8_t *data, const uint16_t *palette, uint8_t xs, uint8_t ys) {
+    rectangle r = {x, x+width-1, y, y+height-1};
+    dl_op *op;
+    if (dl_clipped(&r)) {
+        fill_image_pgm_indexed_scaled(x, y, width, height, data, palette, xs, ys);
+        return;
+    }
+    op = dl_image(&r, DL_IMAGE_IDX);
+    op->scale = xs << 4 | ys;
+    op->arg.idx.data = data;
+    op->arg.idx.palette = palette;
+}
+
+void dl_fill_image_pgm_indexed(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                               const uint8_t *data, const uint16_t *palette) {
+    dl_indexed(x, y, width, height, data, palette, 1, 1);
+}
+
+void dl_fill_image_pgm_indexed_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                  const uint8_t *data, const uint16_t *palette) {
+    dl_indexed(x, y, width, height, data, palette, 2, 1);
+}
+
+void dl_fill_image_pgm_indexed_scaled(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                      const uint8_t *data, const uint16_t *palette,
+                                      uint8_t xs, uint8_t ys) {
+    dl_indexed(x, y, width, height, data, palette, xs, ys);
+}
+
+/*  Spans only touch some pixels of their bounding box, so they hide
+    nothing recorded before them; the box keeps the order with the
+    operations that overlap it. Without data the spans are filled
+    with col. */
+static void dl_spans(uint16_t x, uint16_t y, const uint8_t *spans,
+                     const uint8_t *data, const uint16_t *palette, uint16_t col) {
+    uint8_t xs = pgm_read_byte(spans + 3);
+    uint8_t ys = pgm_read_byte(spans + 4);
+    int8_t bx = pgm_read_byte(spans + 5);
+    int8_t by = pgm_read_byte(spans + 6);
+    rectangle r = {x + xs*bx, x + xs*(bx + pgm_read_byte(spans + 7)) - 1,
+                   y + ys*by, y + ys*(by + pgm_read_byte(spans + 8)) - 1};
+    dl_op *op;
+    if (!pgm_read_byte(spans))
+        return;
+    if (dl_clipped(&r)) {
+        if (data)
+            fill_image_pgm_spans(x, y, spans, data, palette);
+        else
+            fill_spans(x, y, spans, col);
+        return;
+    }
+    /* the caller asked for the whole sprite */
+    dl_requested += (uint16_t)pgm_read_byte(spans + 1) * pgm_read_byte(spans + 2) * xs * ys;
+    if (data) {
+        op = dl_push(&r, DL_SPANS);
+        op->arg.idx.data = data;
+        op->arg.idx.palette = palette;
+        op->arg.idx.spans = spans;
+    } else {
+        op = dl_push(&r, DL_SPANS_FILL);
+        op->arg.mask.spans = spans;
+        op->arg.mask.col = col;
+    }
+}
+
+void dl_fill_image_pgm_spans(uint16_t x, uint16_t y, const uint8_t *spans,
+                             const uint8_t *data, const uint16_t *palette) {
+    dl_spans(x, y, spans, data, palette, 0);
+}
+
+void dl_fill_spans(uint16_t x, uint16_t y, const uint8_t *spans, uint16_t col) {
+    dl_spans(x, y, spans, NULL, NULL, col);
+}
+
+void dl_flush() {
+    uint8_t i;
+#ifdef LCD_STATS
+    bus_stats *caller = lcd_bus;
+#endif
+    for(i=0; i<dl_count; i++) {
+        rectangle *r = &dl_ops[i].r;
+        uint16_t w = r->right - r->left + 1;
+        uint16_t h = r->bottom - r->top + 1;
+        const uint8_t *spans;
+        uint16_t x, y;
+#ifdef LCD_STATS
+        lcd_stats_category(dl_ops[i].category);
+#endif
+        if (dl_ops[i].op == DL_SPANS)
+            dl_sent += pgm_read_word(dl_ops[i].arg.idx.spans + 9);
+        else if (dl_ops[i].op == DL_SPANS_FILL)
+            dl_sent += pgm_read_word(dl_ops[i].arg.mask.spans + 9);
+        else
+            dl_sent += rect_area(r);
+        switch(dl_ops[i].op) {
+            case DL_FILL:
+                fill_rectangle(*r, dl_ops[i].arg.col);
+                break;
+            case DL_IMAGE_PGM:
+                fill_image_pgm(r->left, r->top, w, h, dl_ops[i].arg.img);
+                break;
+            case DL_IMAGE_PGM_2B:
+                fill_image_pgm_2b(r->left, r->top, w, h, dl_ops[i].arg.img);
+                break;
+            case DL_IMAGE_RLE:
+                fill_image_pgm_rle(r->left, r->top, w, h, dl_ops[i].arg.rle);
+                break;
+            case DL_IMAGE_RLE_2B:
+                fill_image_pgm_rle_2b(r->left, r->top, w, h, dl_ops[i].arg.rle);
+                break;
+            case DL_IMAGE_IDX:
+                fill_image_pgm_indexed_scaled(r->left, r->top, w, h, dl_ops[i].arg.idx.data,
+                                              dl_ops[i].arg.idx.palette,
+                                              dl_ops[i].scale >> 4, dl_ops[i].scale & 0x0F);
+                break;
+            case DL_SPANS:
+            case DL_SPANS_FILL:
+                spans = dl_ops[i].op == DL_SPANS ? dl_ops[i].arg.idx.spans
+                                                 : dl_ops[i].arg.mask.spans;
+                /* back from the bounding box to the sprite position */
+                x = r->left - pgm_read_byte(spans + 3) * (int8_t)pgm_read_byte(spans + 5);
+                y = r->top - pgm_read_byte(spans + 4) * (int8_t)pgm_read_byte(spans + 6);
+                if (dl_ops[i].op == DL_SPANS)
+                    fill_image_pgm_spans(x, y, spans, dl_ops[i].arg.idx.data,
+                                         dl_ops[i].arg.idx.palette);
+                else
+                    fill_spans(x, y, spans, dl_ops[i].arg.mask.col);
+                break;
+        }
+    }
+#ifdef LCD_STATS
+    lcd_bus = caller;
+#endif
+    dl_count = 0;
+}
+
+void dl_end() {
+    dl_flush();
+    display_list_stats.requested = dl_requested;
+    display_list_stats.sent = dl_sent;
+}
+
 
 void clear_screen() {
     display.x = 0;
@@ -393,22 +1128,13 @@ void display_char_col(char c, uint16_t fg, uint16_t bg) {
 
     if (c < 32 || c > 126) return;
     fdata = (c - ' ')*5 + font5x7;
-    write_cmd(PAGE_ADDRESS_SET);
-    write_data16(sp);
-    write_data16(ep);
     for(x=sc; x<=ec; x++) {
-        write_cmd(COLUMN_ADDRESS_SET);
-        write_data16(x);
-        write_data16(x);
-        write_cmd(MEMORY_WRITE);
+        set_window(x, x, sp, ep);
         bits = pgm_read_byte(fdata++);
         for(y=sp, mask=0x01; y<=ep; y++, mask<<=1)
             write_data16((bits & mask) ? fg : bg);
     }
-    write_cmd(COLUMN_ADDRESS_SET);
-    write_data16(x);
-    write_data16(x);
-    write_cmd(MEMORY_WRITE);
+    set_window(x, x, sp, ep);
     for(y=sp; y<=ep; y++)
         write_data16(bg);
 
@@ -420,10 +1146,66 @@ void display_char(char c) {
     display_char_col(c, display.foreground, display.background);
 }
 
+/*  Draw the first n characters of str (len of them printable) at the
+    cursor, through a single address window streamed row by row from
+    font5x7_rows.
+    Bus writes for a string of len characters:
+      display_char_col, per character:  13 commands + 28 address bytes
+                                        + 96 pixel bytes = 137
+      display_line, per string:          3 commands +  8 address bytes
+                           per character:              96 pixel bytes
+    so a five digit score goes from 685 to 491 writes, and the address
+    setup is paid once per line instead of seven times per character.
+*/
+static void display_line(char *str, uint8_t n, uint8_t len, uint16_t fg, uint16_t bg) {
+    uint8_t row, i, bits;
+    char c;
+    set_window(display.x, display.x + 6*len - 1, display.y, display.y + 7);
+    for(row=0; row<7; row++) {
+        for(i=0; i<n; i++) {
+            c = str[i];
+            if (c < 32 || c > 126) continue;
+            bits = pgm_read_byte(font5x7_rows + (c - ' ')*7 + row);
+            write_data16((bits & 0x80) ? fg : bg);
+            write_data16((bits & 0x40) ? fg : bg);
+            write_data16((bits & 0x20) ? fg : bg);
+            write_data16((bits & 0x10) ? fg : bg);
+            write_data16((bits & 0x08) ? fg : bg);
+            write_data16(bg);
+        }
+    }
+    write_run(bg, 6*len);
+    display.x += 6*len;
+}
+
+/*  Same layout rules as repeated display_char_col calls, except that a
+    character which would not fit entirely on the line moves to the next.
+*/
+static void display_text(char *str, uint16_t fg, uint16_t bg) {
+    uint8_t n, len;
+    char c;
+    while(*str) {
+        if (*str == '\n') {
+            display_char_col(*str++, fg, bg);
+            continue;
+        }
+        for(n=0, len=0; (c = str[n]) && c != '\n'; n++) {
+            if (c < 32 || c > 126) continue;
+            if (display.x + 6*(len+1) > display.width) break;
+            len++;
+        }
+        if (len)
+            display_line(str, n, len, fg, bg);
+        str += n;
+        if (c && c != '\n') {
+            display.x = 0;
+            display.y += 8;
+        }
+    }
+}
+
 void display_string_col(char *str, uint16_t col) {
-    uint8_t i;
-    for(i=0; str[i]; i++) 
-        display_char_col(str[i], col, display.background);
+    display_text(str, col, display.background);
 }
 
 void display_string(char *str) {
@@ -431,11 +1213,9 @@ void display_string(char *str) {
 }
 
 void display_string_xy_col(char *str, uint16_t x, uint16_t y, uint16_t col) {
-    uint8_t i;
     display.x = x;
     display.y = y;
-    for(i=0; str[i]; i++)
-        display_char_col(str[i], col, display.background);
+    display_text(str, col, display.background);
 }
 
 void display_string_xy(char *str, uint16_t x, uint16_t y) {
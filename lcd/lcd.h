@@ -17,24 +17,75 @@
 
 typedef enum {North, West, South, East} orientation;
 
+typedef struct {
+	uint16_t left, right;
+	uint16_t top, bottom;
+} rectangle;
+
 typedef struct {
 	uint16_t width, height;
 	orientation orient;
 	uint16_t x, y;
 	uint16_t foreground, background;
+	uint16_t win_left, win_right;	/* column window of the controller */
+	uint16_t win_top;		/* first page, the last is height-1 */
+	uint16_t win_next;		/* page following the last memory write */
+	rectangle clip;			/* drawing is clipped to this, see set_clip() */
 } lcd;
 
+#define WIN_INVALID	0xFFFF
+
 extern lcd display;
 
+/* Address setup bytes (command + parameters) sent and skipped thanks
+   to the window shadow. Running totals, reset them as needed. */
 typedef struct {
-	uint16_t left, right;
-	uint16_t top, bottom;
-} rectangle;
+	uint16_t sent;
+	uint16_t saved;
+} window_stats;
+
+extern window_stats lcd_window_stats;
+
+#ifdef LCD_STATS
+/* Bus traffic, counted when built with LCD_STATS: bytes written or
+   read, split by category, the caller picks the one counted with
+   lcd_stats_category(). The display list keeps the category of each
+   operation until it is flushed. Running totals, reset as needed. */
+#define LCD_STATS_CATEGORIES	5
+
+typedef struct {
+	uint16_t commands;	/* command bytes */
+	uint32_t bytes;		/* data bytes, parameters and pixels */
+	uint16_t windows;	/* memory writes started */
+	uint32_t pixels;	/* pixels written */
+} bus_stats;
+
+extern bus_stats lcd_bus_stats[LCD_STATS_CATEGORIES];
+extern bus_stats *lcd_bus;	/* category being counted */
+
+#define lcd_stats_category(c)	(lcd_bus = &lcd_bus_stats[c])
+void lcd_stats_reset();
+#else
+#define lcd_stats_category(c)
+#endif
 
 void init_lcd();
 void lcd_brightness(uint8_t i);
 void set_orientation(orientation o);
 void set_frame_rate_hz(uint8_t f);
+void set_idle_frame_rate_hz(uint8_t f);
+void set_partial_area(uint16_t first, uint16_t last);
+void partial_mode(uint8_t on);
+void idle_mode(uint8_t on);
+void set_scroll_area(uint16_t first, uint16_t last);
+void set_scroll_offset(uint16_t n);
+void scroll_reset();
+/* Images and fills draw exactly width by height pixels (rectangles are
+   inclusive), clipped to display.clip, the whole screen by default.
+   Positions may be negative (cast to uint16_t) for sprites partly off
+   the left or top edge. Text is not clipped. */
+void set_clip(rectangle r);
+void clip_reset();
 void clear_screen();
 void fill_rectangle(rectangle r, uint16_t col);
 void fill_rectangle_c(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t col);
@@ -50,6 +101,14 @@ void display_register(uint8_t reg);
 void fill_image(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col);
 void fill_image_pgm(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col);
 void fill_image_pgm_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col);
+void fill_image_pgm_rle(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data);
+void fill_image_pgm_rle_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data);
+void fill_image_pgm_indexed(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data, const uint16_t *palette);
+void fill_image_pgm_indexed_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data, const uint16_t *palette);
+void fill_image_pgm_indexed_scaled(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data, const uint16_t *palette, uint8_t xs, uint8_t ys);
+void fill_image_pgm_spans(uint16_t x, uint16_t y, const uint8_t *spans, const uint8_t *data, const uint16_t *palette);
+void fill_spans(uint16_t x, uint16_t y, const uint8_t *spans, uint16_t col);
+void read_rectangle(rectangle r, uint16_t *buf);
 void display_uint8(uint8_t i);
 void display_uint16(uint16_t i);
 void display_uint32(uint32_t i);
@@ -57,4 +116,48 @@ void display_uint16_xy_col(uint16_t i, uint16_t x, uint16_t y, uint16_t col);
 void display_uint16_xy(uint16_t i, uint16_t x, uint16_t y);
 void display_uint16_col(uint16_t i, uint16_t col);
 void display_uint8_xy_col(uint8_t i, uint16_t x, uint16_t y, uint16_t col);
+char* shorttoa(uint16_t i, char b[]);
+
+/* Save-under: what a small sprite hides, read back from the controller
+   so that it can be put back when the sprite moves. Restore in the
+   reverse order of saving, before drawing anything else over them. */
+typedef struct {
+	rectangle r;
+	uint8_t saved;
+	uint16_t *buf;      /* room for the whole area */
+} save_under;
+
+void save_under_area(save_under *s, rectangle r);
+void restore_under(save_under *s);
+
+/* Display list: record a frame between dl_begin() and dl_end(),
+   redundant pixels are removed before anything reaches the bus.
+   dl_flush() sends what has been recorded so far. A full list is
+   flushed early, which only loses the merging across the flush.
+   DL_SIZE is the worst play frame: 6 lasers, 2 cannon, 2 astro and
+   15 events (4 explosions ending and 11 monster steps fill the render
+   budget), 25 operations of 16 bytes. */
+#define DL_SIZE     25
+
+typedef struct {
+	uint32_t requested;	/* pixels asked for by the callers */
+	uint32_t sent;		/* pixels written to the controller */
+} dl_stats;
+
+extern dl_stats display_list_stats;	/* totals of the last frame */
+
+void dl_begin();
+void dl_fill_rectangle(rectangle r, uint16_t col);
+void dl_fill_rectangle_c(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t col);
+void dl_fill_image_pgm(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col);
+void dl_fill_image_pgm_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *col);
+void dl_fill_image_pgm_rle(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data);
+void dl_fill_image_pgm_rle_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data);
+void dl_fill_image_pgm_indexed(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data, const uint16_t *palette);
+void dl_fill_image_pgm_indexed_2b(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data, const uint16_t *palette);
+void dl_fill_image_pgm_indexed_scaled(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data, const uint16_t *palette, uint8_t xs, uint8_t ys);
+void dl_fill_image_pgm_spans(uint16_t x, uint16_t y, const uint8_t *spans, const uint8_t *data, const uint16_t *palette);
+void dl_fill_spans(uint16_t x, uint16_t y, const uint8_t *spans, uint16_t col);
+void dl_flush();
+void dl_end();
 #endif /* LCD_H */
@@ -0,0 +1,62 @@
+/*
+  render.c
+  Per frame render budget for AVR90USB1286
+  Up to 8 jobs, the carried ones are kept in a bit mask.
+*/
+
+#include <stdint.h>
+#include "render.h"
+
+render_stats render_frame_stats;
+
+static const render_job *render_jobs;
+static uint8_t render_count;
+static uint8_t render_carried; //Bit i: job i was skipped last frame
+static uint8_t render_next;    //The same for this frame
+static uint8_t render_bit;     //Bit of the job drawing
+
+void render_init(const render_job *jobs, uint8_t count, uint32_t budget) {
+    render_jobs = jobs;
+    render_count = count;
+    render_carried = 0;
+    render_frame_stats.budget = budget;
+    render_frame_stats.used = 0;
+    render_frame_stats.run = 0;
+    render_frame_stats.carried = 0;
+    render_frame_stats.carried_total = 0;
+    render_frame_stats.over = 0;
+    render_frame_stats.overruns = 0;
+}
+
+void render_unfinished(void) {
+    render_next |= render_bit;
+    render_frame_stats.carried++;
+    render_frame_stats.carried_total++;
+}
+
+void render_frame(void) {
+    uint8_t i, bit;
+    uint32_t cost, left, used = 0;
+    render_next = 0;
+    render_frame_stats.run = 0;
+    render_frame_stats.carried = 0;
+    for(i = 0, bit = 1; i < render_count; i++, bit <<= 1) {
+        cost = render_jobs[i].cost();
+        left = used < render_frame_stats.budget ? render_frame_stats.budget - used : 0;
+        if(cost > left && !(render_carried & bit)) {
+            render_bit = bit;
+            render_unfinished();
+            continue;
+        }
+        render_bit = bit;
+        used += render_jobs[i].draw(left);
+        render_frame_stats.run++;
+    }
+    render_carried = render_next;
+    render_frame_stats.used = used;
+    render_frame_stats.over = 0;
+    if(used > render_frame_stats.budget) {
+        render_frame_stats.over = used - render_frame_stats.budget;
+        render_frame_stats.overruns++;
+    }
+}
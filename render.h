@@ -0,0 +1,67 @@
+/*
+  render.h
+  Per frame render budget for AVR90USB1286
+  Draw jobs are run in priority order until the cycles of a frame are
+  spent; the rest waits for the next frame.
+*/
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdint.h>
+
+//Drawing cycles per frame: 8MHz / 61Hz = 131k, less the game logic
+#define RENDER_BUDGET           90000UL
+
+//Bus cost estimate of the drawing functions, in CPU cycles.
+#define RENDER_OP_CYCLES        300 //Window setup and call overhead
+#define RENDER_PIXEL_CYCLES     16  //Average of fills and images
+
+#define render_cost(ops, pixels) \
+    ((uint32_t)(ops) * RENDER_OP_CYCLES + (uint32_t)(pixels) * RENDER_PIXEL_CYCLES)
+
+/*
+  A draw job. cost() estimates the cycles draw() needs now to make
+  progress, it is called every frame. draw() is given the cycles left
+  in the budget (0 when it runs over it) and returns the cycles it
+  spent. A job that can be split draws what fits, one piece at least,
+  and calls render_unfinished() for the rest. draw() must work out
+  what changed itself, as a job can be skipped for a frame.
+*/
+typedef struct {
+    uint32_t (*cost)(void);
+    uint32_t (*draw)(uint32_t left);
+} render_job;
+
+typedef struct {
+    uint32_t budget;        //Cycles per frame
+    uint32_t used;          //Estimated cycles of the last frame
+    uint8_t run;            //Jobs run by the last frame
+    uint8_t carried;        //Jobs left for the next frame
+    uint16_t carried_total; //Carry overs since render_init()
+    uint32_t over;          //Cycles the last frame went over the budget
+    uint16_t overruns;      //Frames over the budget since render_init()
+} render_stats;
+
+extern render_stats render_frame_stats;
+
+/*
+  Set the jobs, highest priority first, and the cycles to spend on
+  them every frame.
+*/
+void render_init(const render_job *jobs, uint8_t count, uint32_t budget);
+
+/*
+  Run the jobs of a frame. A job runs if it fits in what is left of
+  the budget, or if it was already carried over once: nothing waits
+  more than a frame, and a frame overruns by one piece of a job at
+  most. Overruns are counted in render_frame_stats.
+*/
+void render_frame(void);
+
+/*
+  Called by the draw() running when it leaves work for the next frame,
+  where it is carried over.
+*/
+void render_unfinished(void);
+
+#endif /* RENDER_H */
@@ -0,0 +1,46 @@
+/*
+  sched.c
+  Cooperative task scheduler for AVR90USB1286
+  Idle sleep: the timers and the tearing interrupt still wake it up.
+*/
+
+#include <stdint.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "sched.h"
+
+static task *sched_tasks;
+static uint8_t sched_count;
+
+void sched_init(task *tasks, uint8_t count) {
+    uint8_t i;
+    sched_tasks = tasks;
+    sched_count = count;
+    for(i = 0; i < count; i++) {
+        tasks[i].pending = 0;
+        tasks[i].missed = 0;
+    }
+    set_sleep_mode(SLEEP_MODE_IDLE);
+}
+
+void sched_run(void) {
+    uint8_t i;
+    for(i = 0; i < sched_count; i++) {
+        if(sched_tasks[i].pending) {
+            sched_tasks[i].pending = 0;
+            sched_tasks[i].run();
+            return;
+        }
+    }
+    //Check again with interrupts off: the instruction after sei() runs
+    //before any interrupt, so a post cannot slip in before the sleep.
+    cli();
+    for(i = 0; i < sched_count && !sched_tasks[i].pending; i++);
+    if(i == sched_count) {
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    sei();
+}
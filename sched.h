@@ -0,0 +1,42 @@
+/*
+  sched.h
+  Cooperative task scheduler for AVR90USB1286
+  Interrupts only post tasks. The main loop runs them one at a time,
+  highest priority first, and sleeps when none is waiting.
+*/
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+
+/*
+  A task. run() goes to completion, no other task starts before it
+  returns. A task posted again before it has run missed its deadline.
+*/
+typedef struct {
+    void (*run)(void);
+    volatile uint8_t pending;   //Posted and not run yet
+    volatile uint16_t missed;   //Deadline misses since sched_init()
+} task;
+
+/*
+  Set the tasks, highest priority first.
+*/
+void sched_init(task *tasks, uint8_t count);
+
+/*
+  Post a task, from the interrupt that it waits for.
+*/
+static inline void sched_post(task *t) {
+    if(t->pending)
+        t->missed++;
+    t->pending = 1;
+}
+
+/*
+  Run the highest priority task waiting or, if there is none, sleep
+  until the next interrupt. Called with interrupts enabled.
+*/
+void sched_run(void);
+
+#endif /* SCHED_H */
@@ -0,0 +1,339 @@
+/*
+  sprites.h
+  Generated by tools/spritec.py from image.h, do not edit.
+  See image.h for the source art and spritec.py for the formats.
+*/
+
+#ifndef SPRITES_H
+#define SPRITES_H
+#include <avr/pgmspace.h>
+#include <stdint.h>
+
+//27x11, RLE 8 runs = 24B (raw 594B)
+static const uint8_t cannon_sprite_rle[24] PROGMEM = {
+    0x0B,0x00,0x00,0x04,0x00,0x04,0x16,0x00,0x00,0x06,0x00,0x04,0x15,0x00,0x00,0x06,0x00,0x04,0x0B,0x00,0x00,0xD8,0x00,0x04
+};
+
+//27x11, 1bpp indexed = 49B, 2 colours (raw 594B)
+static const uint16_t cannon_sprite_2_pal[2] PROGMEM = {
+    0x0000,0x0400
+};
+
+static const uint8_t cannon_sprite_2_idx[45] PROGMEM = {
+    0x01,0x00,0x12,0x00,0x00,0x00,0x04,0x41,0x00,0x12,0x2A,0x08,0x80,0xAC,0x41,0x90,0x60,0x05,0x00,0x88,0x00,0xAA,0xA9,0x25,
+    0x40,0x11,0x14,0x92,0x80,0x40,0x5E,0x28,0x80,0x96,0xBE,0x94,0x60,0x0B,0x37,0xFC,0x80,0x2E,0xFF,0x77,0x40
+};
+
+//27x11, 1bpp indexed = 49B, 2 colours (raw 594B)
+static const uint16_t cannon_sprite_3_pal[2] PROGMEM = {
+    0x0000,0x0400
+};
+
+static const uint8_t cannon_sprite_3_idx[45] PROGMEM = {
+    0x01,0x00,0x10,0x00,0x40,0x20,0x01,0x44,0x40,0x29,0x02,0x12,0x20,0x44,0x20,0x28,0x80,0x04,0x80,0x83,0x00,0x90,0xA8,0x25,
+    0x20,0xC2,0x14,0x00,0x00,0x20,0x2C,0x11,0x40,0x84,0xFB,0x82,0x00,0x19,0x37,0x78,0x80,0xD6,0xE6,0xED,0x40
+};
+
+//9x8, 2bpp indexed = 31B, 3 colours (raw 144B)
+static const uint16_t heart_sprite_pal[3] PROGMEM = {
+    0x0000,0xF800,0xFFFF
+};
+
+static const uint8_t heart_sprite_idx[25] PROGMEM = {
+    0x02,0x14,0x05,0x00,0x55,0x15,0x40,0x55,0x56,0x40,0x55,0x59,0x40,0x15,0x55,0x00,0x05,0x54,0x00,0x01,0x50,0x00,0x00,0x40,
+    0x00
+};
+
+//16x7 drawn 2x2, 2bpp indexed = 35B, 3 colours (raw 224B)
+static const uint16_t astro_sprite_pal[3] PROGMEM = {
+    0x0000,0xF800,0x8800
+};
+
+static const uint8_t astro_sprite_idx[29] PROGMEM = {
+    0x02,0x00,0x15,0x56,0x00,0x01,0x55,0x55,0x60,0x05,0x55,0x55,0x58,0x14,0x51,0x45,0x16,0x55,0x55,0x55,0x55,0x05,0x61,0x61,
+    0x58,0x01,0x80,0x00,0x60
+};
+
+//13x8 drawn 2x2, 1bpp indexed = 17B, 2 colours (raw 208B)
+static const uint8_t monster_sprite_1A_idx[17] PROGMEM = {
+    0x01,0x06,0x00,0x0F,0x00,0x1F,0x80,0x36,0xC0,0x3F,0xC0,0x16,0x80,0x20,0x40,0x10,0x80
+};
+
+//13x8 drawn 2x2, 1bpp indexed = 17B, 2 colours (raw 208B)
+static const uint8_t monster_sprite_1B_idx[17] PROGMEM = {
+    0x01,0x06,0x00,0x0F,0x00,0x1F,0x80,0x36,0xC0,0x3F,0xC0,0x09,0x00,0x16,0x80,0x29,0x40
+};
+
+//13x8 drawn 2x2, 1bpp indexed = 17B, 2 colours (raw 208B)
+static const uint8_t monster_sprite_2A_idx[17] PROGMEM = {
+    0x01,0x10,0x40,0x08,0x80,0x1F,0xC0,0x37,0x60,0x7F,0xF0,0x5F,0xD0,0x50,0x50,0x0D,0x80
+};
+
+//13x8 drawn 2x2, 1bpp indexed = 17B, 2 colours (raw 208B)
+static const uint8_t monster_sprite_2B_idx[17] PROGMEM = {
+    0x01,0x10,0x40,0x48,0x90,0x5F,0xD0,0x77,0x70,0x7F,0xF0,0x1F,0xC0,0x10,0x40,0x20,0x20
+};
+
+//13x8 drawn 2x2, 1bpp indexed = 17B, 2 colours (raw 208B)
+static const uint8_t monster_sprite_3A_idx[17] PROGMEM = {
+    0x01,0x0F,0x00,0x7F,0xE0,0xFF,0xF0,0xE6,0x70,0xFF,0xF0,0x39,0xC0,0x66,0x60,0x30,0xC0
+};
+
+//13x8 drawn 2x2, 1bpp indexed = 17B, 2 colours (raw 208B)
+static const uint8_t monster_sprite_3B_idx[17] PROGMEM = {
+    0x01,0x0F,0x00,0x7F,0xE0,0xFF,0xF0,0xE6,0x70,0xFF,0xF0,0x19,0x80,0x36,0xC0,0xC0,0x30
+};
+
+//13x8 drawn 2x2, 1bpp indexed = 21B, 2 colours (raw 208B)
+static const uint16_t monster_sprite_exp_pal[2] PROGMEM = {
+    0x0000,0xFFFF
+};
+
+static const uint8_t monster_sprite_exp_idx[17] PROGMEM = {
+    0x01,0x48,0x90,0x25,0x20,0x10,0x40,0xC0,0x18,0x10,0x40,0x25,0x20,0x48,0x90,0x00,0x00
+};
+
+//4x7, 1bpp indexed = 12B, 2 colours (raw 56B)
+static const uint16_t triangle_sprite_pal[2] PROGMEM = {
+    0x0000,0x001F
+};
+
+static const uint8_t triangle_sprite_idx[8] PROGMEM = {
+    0x01,0x80,0xC0,0xE0,0xF0,0xE0,0xC0,0x80
+};
+
+//monster_sprite_1A -> monster_sprite_1B moved 8,0: 12 spans, 252 pixels = 59B
+static const uint8_t monster_delta_1AB_r[59] PROGMEM = {
+    0x0C,0x0D,0x08,0x02,0x02,0xFE,0x00,0x0C,0x08,0xFC,0x00,0x01,0x00,0x06,0x01,0x00,0x01,0x08,0x01,0xFF,0x02,0x0A,0x01,0xFE,
+    0x03,0x0C,0x01,0xFE,0x04,0x04,0x01,0x06,0x04,0x04,0x01,0xFF,0x05,0x04,0x01,0x07,0x05,0x01,0x01,0xFE,0x06,0x01,0x01,0x03,
+    0x06,0x06,0x01,0xFF,0x07,0x04,0x01,0x07,0x07,0x03,0x01
+};
+
+//monster_sprite_1A -> monster_sprite_1B moved -8,0: 12 spans, 252 pixels = 59B
+static const uint8_t monster_delta_1AB_l[59] PROGMEM = {
+    0x0C,0x0D,0x08,0x02,0x02,0x02,0x00,0x0C,0x08,0xFC,0x00,0x05,0x00,0x06,0x01,0x04,0x01,0x08,0x01,0x03,0x02,0x0A,0x01,0x02,
+    0x03,0x0C,0x01,0x02,0x04,0x04,0x01,0x0A,0x04,0x04,0x01,0x04,0x05,0x01,0x01,0x09,0x05,0x04,0x01,0x03,0x06,0x06,0x01,0x0D,
+    0x06,0x01,0x01,0x02,0x07,0x03,0x01,0x09,0x07,0x04,0x01
+};
+
+//monster_sprite_1A -> monster_sprite_1B moved 8,8: 13 spans, 328 pixels = 63B
+static const uint8_t monster_delta_1AB_rd[63] PROGMEM = {
+    0x0D,0x0D,0x08,0x02,0x02,0xFE,0xFC,0x0C,0x0C,0x48,0x01,0x01,0xFC,0x02,0x01,0x00,0xFD,0x04,0x01,0xFF,0xFE,0x06,0x01,0xFE,
+    0xFF,0x08,0x01,0xFE,0x00,0x09,0x01,0xFF,0x01,0x09,0x01,0xFE,0x02,0x01,0x01,0x03,0x02,0x06,0x01,0xFF,0x03,0x0B,0x01,0x02,
+    0x04,0x08,0x01,0x04,0x05,0x04,0x01,0x03,0x06,0x06,0x01,0x02,0x07,0x08,0x01
+};
+
+//monster_sprite_1A -> monster_sprite_1B moved -8,8: 13 spans, 328 pixels = 63B
+static const uint8_t monster_delta_1AB_ld[63] PROGMEM = {
+    0x0D,0x0D,0x08,0x02,0x02,0x02,0xFC,0x0C,0x0C,0x48,0x01,0x09,0xFC,0x02,0x01,0x08,0xFD,0x04,0x01,0x07,0xFE,0x06,0x01,0x06,
+    0xFF,0x08,0x01,0x05,0x00,0x09,0x01,0x04,0x01,0x09,0x01,0x03,0x02,0x06,0x01,0x0D,0x02,0x01,0x01,0x02,0x03,0x0B,0x01,0x02,
+    0x04,0x08,0x01,0x04,0x05,0x04,0x01,0x03,0x06,0x06,0x01,0x02,0x07,0x08,0x01
+};
+
+//monster_sprite_1B -> monster_sprite_1A moved 8,0: 12 spans, 252 pixels = 59B
+static const uint8_t monster_delta_1BA_r[59] PROGMEM = {
+    0x0C,0x0D,0x08,0x02,0x02,0xFE,0x00,0x0C,0x08,0xFC,0x00,0x01,0x00,0x06,0x01,0x00,0x01,0x08,0x01,0xFF,0x02,0x0A,0x01,0xFE,
+    0x03,0x0C,0x01,0xFE,0x04,0x04,0x01,0x06,0x04,0x04,0x01,0x00,0x05,0x01,0x01,0x05,0x05,0x04,0x01,0xFF,0x06,0x06,0x01,0x09,
+    0x06,0x01,0x01,0xFE,0x07,0x03,0x01,0x05,0x07,0x04,0x01
+};
+
+//monster_sprite_1B -> monster_sprite_1A moved -8,0: 12 spans, 252 pixels = 59B
+static const uint8_t monster_delta_1BA_l[59] PROGMEM = {
+    0x0C,0x0D,0x08,0x02,0x02,0x02,0x00,0x0C,0x08,0xFC,0x00,0x05,0x00,0x06,0x01,0x04,0x01,0x08,0x01,0x03,0x02,0x0A,0x01,0x02,
+    0x03,0x0C,0x01,0x02,0x04,0x04,0x01,0x0A,0x04,0x04,0x01,0x03,0x05,0x04,0x01,0x0B,0x05,0x01,0x01,0x02,0x06,0x01,0x01,0x07,
+    0x06,0x06,0x01,0x03,0x07,0x04,0x01,0x0B,0x07,0x03,0x01
+};
+
+//monster_sprite_1B -> monster_sprite_1A moved 8,8: 15 spans, 296 pixels = 71B
+static const uint8_t monster_delta_1BA_rd[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0xFE,0xFC,0x0C,0x0C,0x28,0x01,0x01,0xFC,0x02,0x01,0x00,0xFD,0x04,0x01,0xFF,0xFE,0x06,0x01,0xFE,
+    0xFF,0x08,0x01,0xFE,0x00,0x09,0x01,0x00,0x01,0x08,0x01,0xFF,0x02,0x0A,0x01,0xFE,0x03,0x05,0x01,0x06,0x03,0x04,0x01,0x02,
+    0x04,0x08,0x01,0x03,0x05,0x06,0x01,0x02,0x06,0x01,0x01,0x09,0x06,0x01,0x01,0x03,0x07,0x01,0x01,0x08,0x07,0x01,0x01
+};
+
+//monster_sprite_1B -> monster_sprite_1A moved -8,8: 15 spans, 296 pixels = 71B
+static const uint8_t monster_delta_1BA_ld[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0x02,0xFC,0x0C,0x0C,0x28,0x01,0x09,0xFC,0x02,0x01,0x08,0xFD,0x04,0x01,0x07,0xFE,0x06,0x01,0x06,
+    0xFF,0x08,0x01,0x05,0x00,0x09,0x01,0x04,0x01,0x08,0x01,0x03,0x02,0x0A,0x01,0x02,0x03,0x04,0x01,0x09,0x03,0x05,0x01,0x02,
+    0x04,0x08,0x01,0x03,0x05,0x06,0x01,0x02,0x06,0x01,0x01,0x09,0x06,0x01,0x01,0x03,0x07,0x01,0x01,0x08,0x07,0x01,0x01
+};
+
+//monster_sprite_2A -> monster_sprite_2B moved 8,0: 17 spans, 248 pixels = 79B
+static const uint8_t monster_delta_2AB_r[79] PROGMEM = {
+    0x11,0x0D,0x08,0x02,0x02,0xFD,0x00,0x0F,0x08,0xF8,0x00,0xFF,0x00,0x01,0x01,0x03,0x00,0x03,0x01,0x09,0x00,0x01,0x01,0x00,
+    0x01,0x02,0x01,0x08,0x01,0x04,0x01,0xFF,0x02,0x04,0x01,0x06,0x02,0x06,0x01,0xFE,0x03,0x02,0x01,0x07,0x03,0x05,0x01,0xFD,
+    0x04,0x04,0x01,0x08,0x04,0x04,0x01,0xFD,0x05,0x06,0x01,0x06,0x05,0x04,0x01,0xFD,0x06,0x03,0x01,0x03,0x06,0x07,0x01,0x00,
+    0x07,0x05,0x01,0x0A,0x07,0x01,0x01
+};
+
+//monster_sprite_2A -> monster_sprite_2B moved -8,0: 17 spans, 248 pixels = 79B
+static const uint8_t monster_delta_2AB_l[79] PROGMEM = {
+    0x11,0x0D,0x08,0x02,0x02,0x01,0x00,0x0F,0x08,0xF8,0x00,0x03,0x00,0x01,0x01,0x07,0x00,0x03,0x01,0x0D,0x00,0x01,0x01,0x01,
+    0x01,0x04,0x01,0x0B,0x01,0x02,0x01,0x01,0x02,0x06,0x01,0x0A,0x02,0x04,0x01,0x01,0x03,0x05,0x01,0x0D,0x03,0x02,0x01,0x01,
+    0x04,0x04,0x01,0x0C,0x04,0x04,0x01,0x03,0x05,0x04,0x01,0x0A,0x05,0x06,0x01,0x03,0x06,0x07,0x01,0x0D,0x06,0x03,0x01,0x02,
+    0x07,0x01,0x01,0x08,0x07,0x05,0x01
+};
+
+//monster_sprite_2A -> monster_sprite_2B moved 8,8: 15 spans, 388 pixels = 71B
+static const uint8_t monster_delta_2AB_rd[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0xFD,0xFC,0x0F,0x0C,0x84,0x01,0xFF,0xFC,0x01,0x01,0x05,0xFC,0x01,0x01,0x00,0xFD,0x01,0x01,0x04,
+    0xFD,0x01,0x01,0xFF,0xFE,0x07,0x01,0xFE,0xFF,0x09,0x01,0xFD,0x00,0x0D,0x01,0xFD,0x01,0x0F,0x02,0x00,0x03,0x0C,0x01,0x01,
+    0x04,0x0B,0x01,0x03,0x05,0x07,0x01,0x03,0x06,0x01,0x01,0x09,0x06,0x01,0x01,0x02,0x07,0x01,0x01,0x0A,0x07,0x01,0x01
+};
+
+//monster_sprite_2A -> monster_sprite_2B moved -8,8: 15 spans, 388 pixels = 71B
+static const uint8_t monster_delta_2AB_ld[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0x01,0xFC,0x0F,0x0C,0x84,0x01,0x07,0xFC,0x01,0x01,0x0D,0xFC,0x01,0x01,0x08,0xFD,0x01,0x01,0x0C,
+    0xFD,0x01,0x01,0x07,0xFE,0x07,0x01,0x06,0xFF,0x09,0x01,0x03,0x00,0x0D,0x01,0x01,0x01,0x0F,0x02,0x01,0x03,0x0C,0x01,0x01,
+    0x04,0x0B,0x01,0x03,0x05,0x07,0x01,0x03,0x06,0x01,0x01,0x09,0x06,0x01,0x01,0x02,0x07,0x01,0x01,0x0A,0x07,0x01,0x01
+};
+
+//monster_sprite_2B -> monster_sprite_2A moved 8,0: 17 spans, 248 pixels = 79B
+static const uint8_t monster_delta_2BA_r[79] PROGMEM = {
+    0x11,0x0D,0x08,0x02,0x02,0xFD,0x00,0x0F,0x08,0xF8,0x00,0xFF,0x00,0x01,0x01,0x03,0x00,0x03,0x01,0x09,0x00,0x01,0x01,0xFD,
+    0x01,0x04,0x01,0x07,0x01,0x02,0x01,0xFD,0x02,0x06,0x01,0x06,0x02,0x04,0x01,0xFD,0x03,0x05,0x01,0x09,0x03,0x02,0x01,0xFD,
+    0x04,0x04,0x01,0x08,0x04,0x04,0x01,0xFF,0x05,0x04,0x01,0x06,0x05,0x06,0x01,0xFF,0x06,0x07,0x01,0x09,0x06,0x03,0x01,0xFE,
+    0x07,0x01,0x01,0x04,0x07,0x05,0x01
+};
+
+//monster_sprite_2B -> monster_sprite_2A moved -8,0: 17 spans, 248 pixels = 79B
+static const uint8_t monster_delta_2BA_l[79] PROGMEM = {
+    0x11,0x0D,0x08,0x02,0x02,0x01,0x00,0x0F,0x08,0xF8,0x00,0x03,0x00,0x01,0x01,0x07,0x00,0x03,0x01,0x0D,0x00,0x01,0x01,0x04,
+    0x01,0x02,0x01,0x0C,0x01,0x04,0x01,0x03,0x02,0x04,0x01,0x0A,0x02,0x06,0x01,0x02,0x03,0x02,0x01,0x0B,0x03,0x05,0x01,0x01,
+    0x04,0x04,0x01,0x0C,0x04,0x04,0x01,0x01,0x05,0x06,0x01,0x0A,0x05,0x04,0x01,0x01,0x06,0x03,0x01,0x07,0x06,0x07,0x01,0x04,
+    0x07,0x05,0x01,0x0E,0x07,0x01,0x01
+};
+
+//monster_sprite_2B -> monster_sprite_2A moved 8,8: 15 spans, 424 pixels = 71B
+static const uint8_t monster_delta_2BA_rd[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0xFD,0xFC,0x0F,0x0C,0xA8,0x01,0xFF,0xFC,0x01,0x01,0x05,0xFC,0x01,0x01,0xFD,0xFD,0x04,0x01,0x04,
+    0xFD,0x04,0x01,0xFD,0xFE,0x0B,0x02,0xFD,0x00,0x0D,0x01,0xFF,0x01,0x0A,0x01,0xFF,0x02,0x01,0x01,0x03,0x02,0x07,0x01,0xFE,
+    0x03,0x01,0x01,0x02,0x03,0x09,0x01,0x01,0x04,0x0B,0x02,0x01,0x06,0x03,0x01,0x09,0x06,0x03,0x01,0x04,0x07,0x05,0x01
+};
+
+//monster_sprite_2B -> monster_sprite_2A moved -8,8: 15 spans, 424 pixels = 71B
+static const uint8_t monster_delta_2BA_ld[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0x01,0xFC,0x0F,0x0C,0xA8,0x01,0x07,0xFC,0x01,0x01,0x0D,0xFC,0x01,0x01,0x05,0xFD,0x04,0x01,0x0C,
+    0xFD,0x04,0x01,0x05,0xFE,0x0B,0x02,0x03,0x00,0x0D,0x01,0x04,0x01,0x0A,0x01,0x03,0x02,0x07,0x01,0x0D,0x02,0x01,0x01,0x02,
+    0x03,0x09,0x01,0x0E,0x03,0x01,0x01,0x01,0x04,0x0B,0x02,0x01,0x06,0x03,0x01,0x09,0x06,0x03,0x01,0x04,0x07,0x05,0x01
+};
+
+//monster_sprite_3A -> monster_sprite_3B moved 8,0: 15 spans, 272 pixels = 71B
+static const uint8_t monster_delta_3AB_r[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0xFC,0x00,0x10,0x08,0x10,0x01,0x00,0x00,0x08,0x01,0xFD,0x01,0x04,0x01,0x07,0x01,0x04,0x01,0xFC,
+    0x02,0x04,0x01,0x08,0x02,0x04,0x01,0xFC,0x03,0x05,0x01,0x07,0x03,0x05,0x01,0xFC,0x04,0x04,0x01,0x08,0x04,0x04,0x01,0xFE,
+    0x05,0x03,0x01,0x05,0x05,0x04,0x01,0xFD,0x06,0x07,0x01,0x08,0x06,0x02,0x01,0xFE,0x07,0x08,0x01,0x0A,0x07,0x02,0x01
+};
+
+//monster_sprite_3A -> monster_sprite_3B moved -8,0: 15 spans, 272 pixels = 71B
+static const uint8_t monster_delta_3AB_l[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0x00,0x00,0x10,0x08,0x10,0x01,0x04,0x00,0x08,0x01,0x01,0x01,0x04,0x01,0x0B,0x01,0x04,0x01,0x00,
+    0x02,0x04,0x01,0x0C,0x02,0x04,0x01,0x00,0x03,0x05,0x01,0x0B,0x03,0x05,0x01,0x00,0x04,0x04,0x01,0x0C,0x04,0x04,0x01,0x03,
+    0x05,0x04,0x01,0x0B,0x05,0x03,0x01,0x02,0x06,0x02,0x01,0x08,0x06,0x07,0x01,0x00,0x07,0x02,0x01,0x06,0x07,0x08,0x01
+};
+
+//monster_sprite_3A -> monster_sprite_3B moved 8,8: 13 spans, 460 pixels = 63B
+static const uint8_t monster_delta_3AB_rd[63] PROGMEM = {
+    0x0D,0x0D,0x08,0x02,0x02,0xFC,0xFC,0x10,0x0C,0xCC,0x01,0x00,0xFC,0x04,0x01,0xFD,0xFD,0x0A,0x01,0xFC,0xFE,0x0C,0x02,0xFC,
+    0x00,0x08,0x01,0xFE,0x01,0x05,0x01,0x06,0x01,0x05,0x01,0xFD,0x02,0x0F,0x01,0xFE,0x03,0x0E,0x01,0x00,0x04,0x0C,0x01,0x03,
+    0x05,0x06,0x01,0x02,0x06,0x08,0x01,0x00,0x07,0x02,0x01,0x0A,0x07,0x02,0x01
+};
+
+//monster_sprite_3A -> monster_sprite_3B moved -8,8: 13 spans, 460 pixels = 63B
+static const uint8_t monster_delta_3AB_ld[63] PROGMEM = {
+    0x0D,0x0D,0x08,0x02,0x02,0x00,0xFC,0x10,0x0C,0xCC,0x01,0x08,0xFC,0x04,0x01,0x05,0xFD,0x0A,0x01,0x04,0xFE,0x0C,0x02,0x08,
+    0x00,0x08,0x01,0x01,0x01,0x05,0x01,0x09,0x01,0x05,0x01,0x00,0x02,0x0F,0x01,0x00,0x03,0x0E,0x01,0x00,0x04,0x0C,0x01,0x03,
+    0x05,0x06,0x01,0x02,0x06,0x08,0x01,0x00,0x07,0x02,0x01,0x0A,0x07,0x02,0x01
+};
+
+//monster_sprite_3B -> monster_sprite_3A moved 8,0: 15 spans, 272 pixels = 71B
+static const uint8_t monster_delta_3BA_r[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0xFC,0x00,0x10,0x08,0x10,0x01,0x00,0x00,0x08,0x01,0xFD,0x01,0x04,0x01,0x07,0x01,0x04,0x01,0xFC,
+    0x02,0x04,0x01,0x08,0x02,0x04,0x01,0xFC,0x03,0x05,0x01,0x07,0x03,0x05,0x01,0xFC,0x04,0x04,0x01,0x08,0x04,0x04,0x01,0xFF,
+    0x05,0x04,0x01,0x07,0x05,0x03,0x01,0xFE,0x06,0x02,0x01,0x04,0x06,0x07,0x01,0xFC,0x07,0x02,0x01,0x02,0x07,0x08,0x01
+};
+
+//monster_sprite_3B -> monster_sprite_3A moved -8,0: 15 spans, 272 pixels = 71B
+static const uint8_t monster_delta_3BA_l[71] PROGMEM = {
+    0x0F,0x0D,0x08,0x02,0x02,0x00,0x00,0x10,0x08,0x10,0x01,0x04,0x00,0x08,0x01,0x01,0x01,0x04,0x01,0x0B,0x01,0x04,0x01,0x00,
+    0x02,0x04,0x01,0x0C,0x02,0x04,0x01,0x00,0x03,0x05,0x01,0x0B,0x03,0x05,0x01,0x00,0x04,0x04,0x01,0x0C,0x04,0x04,0x01,0x02,
+    0x05,0x03,0x01,0x09,0x05,0x04,0x01,0x01,0x06,0x07,0x01,0x0C,0x06,0x02,0x01,0x02,0x07,0x08,0x01,0x0E,0x07,0x02,0x01
+};
+
+//monster_sprite_3B -> monster_sprite_3A moved 8,8: 12 spans, 488 pixels = 59B
+static const uint8_t monster_delta_3BA_rd[59] PROGMEM = {
+    0x0C,0x0D,0x08,0x02,0x02,0xFC,0xFC,0x10,0x0C,0xE8,0x01,0x00,0xFC,0x04,0x01,0xFD,0xFD,0x0A,0x01,0xFC,0xFE,0x0C,0x02,0xFC,
+    0x00,0x08,0x01,0xFF,0x01,0x0C,0x01,0xFE,0x02,0x0E,0x01,0xFC,0x03,0x10,0x01,0x00,0x04,0x0C,0x01,0x02,0x05,0x08,0x01,0x01,
+    0x06,0x0A,0x01,0x02,0x07,0x02,0x01,0x08,0x07,0x02,0x01
+};
+
+//monster_sprite_3B -> monster_sprite_3A moved -8,8: 12 spans, 488 pixels = 59B
+static const uint8_t monster_delta_3BA_ld[59] PROGMEM = {
+    0x0C,0x0D,0x08,0x02,0x02,0x00,0xFC,0x10,0x0C,0xE8,0x01,0x08,0xFC,0x04,0x01,0x05,0xFD,0x0A,0x01,0x04,0xFE,0x0C,0x02,0x08,
+    0x00,0x08,0x01,0x01,0x01,0x0C,0x01,0x00,0x02,0x0E,0x01,0x00,0x03,0x10,0x01,0x00,0x04,0x0C,0x01,0x02,0x05,0x08,0x01,0x01,
+    0x06,0x0A,0x01,0x02,0x07,0x02,0x01,0x08,0x07,0x02,0x01
+};
+
+//astro_sprite opaque: 14 spans, 292 of 448 pixels = 67B
+static const uint8_t astro_sprite_spans[67] PROGMEM = {
+    0x0E,0x10,0x07,0x02,0x02,0x00,0x00,0x10,0x07,0x24,0x01,0x05,0x00,0x07,0x01,0x03,0x01,0x0B,0x01,0x02,0x02,0x0D,0x01,0x01,
+    0x03,0x02,0x01,0x04,0x03,0x02,0x01,0x07,0x03,0x02,0x01,0x0A,0x03,0x02,0x01,0x0D,0x03,0x03,0x01,0x00,0x04,0x10,0x01,0x02,
+    0x05,0x04,0x01,0x07,0x05,0x03,0x01,0x0B,0x05,0x04,0x01,0x03,0x06,0x02,0x01,0x0C,0x06,0x02,0x01
+};
+
+//monster_sprite_exp opaque: 22 spans, 96 of 416 pixels = 99B
+static const uint8_t monster_sprite_exp_spans[99] PROGMEM = {
+    0x16,0x0D,0x08,0x02,0x02,0x00,0x00,0x0D,0x07,0x60,0x00,0x01,0x00,0x01,0x01,0x04,0x00,0x01,0x01,0x08,0x00,0x01,0x01,0x0B,
+    0x00,0x01,0x01,0x02,0x01,0x01,0x01,0x05,0x01,0x01,0x01,0x07,0x01,0x01,0x01,0x0A,0x01,0x01,0x01,0x03,0x02,0x01,0x01,0x09,
+    0x02,0x01,0x01,0x00,0x03,0x02,0x01,0x0B,0x03,0x02,0x01,0x03,0x04,0x01,0x01,0x09,0x04,0x01,0x01,0x02,0x05,0x01,0x01,0x05,
+    0x05,0x01,0x01,0x07,0x05,0x01,0x01,0x0A,0x05,0x01,0x01,0x01,0x06,0x01,0x01,0x04,0x06,0x01,0x01,0x08,0x06,0x01,0x01,0x0B,
+    0x06,0x01,0x01
+};
+
+//monster_sprite_1A opaque: 14 spans, 136 of 416 pixels = 67B
+static const uint8_t monster_sprite_1A_spans[67] PROGMEM = {
+    0x0E,0x0D,0x08,0x02,0x02,0x02,0x00,0x08,0x08,0x88,0x00,0x05,0x00,0x02,0x01,0x04,0x01,0x04,0x01,0x03,0x02,0x06,0x01,0x02,
+    0x03,0x02,0x01,0x05,0x03,0x02,0x01,0x08,0x03,0x02,0x01,0x02,0x04,0x08,0x01,0x03,0x05,0x01,0x01,0x05,0x05,0x02,0x01,0x08,
+    0x05,0x01,0x01,0x02,0x06,0x01,0x01,0x09,0x06,0x01,0x01,0x03,0x07,0x01,0x01,0x08,0x07,0x01,0x01
+};
+
+//monster_sprite_1B opaque: 16 spans, 144 of 416 pixels = 75B
+static const uint8_t monster_sprite_1B_spans[75] PROGMEM = {
+    0x10,0x0D,0x08,0x02,0x02,0x02,0x00,0x08,0x08,0x90,0x00,0x05,0x00,0x02,0x01,0x04,0x01,0x04,0x01,0x03,0x02,0x06,0x01,0x02,
+    0x03,0x02,0x01,0x05,0x03,0x02,0x01,0x08,0x03,0x02,0x01,0x02,0x04,0x08,0x01,0x04,0x05,0x01,0x01,0x07,0x05,0x01,0x01,0x03,
+    0x06,0x01,0x01,0x05,0x06,0x02,0x01,0x08,0x06,0x01,0x01,0x02,0x07,0x01,0x01,0x04,0x07,0x01,0x01,0x07,0x07,0x01,0x01,0x09,
+    0x07,0x01,0x01
+};
+
+//monster_sprite_2A opaque: 16 spans, 184 of 416 pixels = 75B
+static const uint8_t monster_sprite_2A_spans[75] PROGMEM = {
+    0x10,0x0D,0x08,0x02,0x02,0x01,0x00,0x0B,0x08,0xB8,0x00,0x03,0x00,0x01,0x01,0x09,0x00,0x01,0x01,0x04,0x01,0x01,0x01,0x08,
+    0x01,0x01,0x01,0x03,0x02,0x07,0x01,0x02,0x03,0x02,0x01,0x05,0x03,0x03,0x01,0x09,0x03,0x02,0x01,0x01,0x04,0x0B,0x01,0x01,
+    0x05,0x01,0x02,0x03,0x05,0x07,0x01,0x0B,0x05,0x01,0x02,0x03,0x06,0x01,0x01,0x09,0x06,0x01,0x01,0x04,0x07,0x02,0x01,0x07,
+    0x07,0x02,0x01
+};
+
+//monster_sprite_2B opaque: 16 spans, 184 of 416 pixels = 75B
+static const uint8_t monster_sprite_2B_spans[75] PROGMEM = {
+    0x10,0x0D,0x08,0x02,0x02,0x01,0x00,0x0B,0x08,0xB8,0x00,0x03,0x00,0x01,0x01,0x09,0x00,0x01,0x01,0x01,0x01,0x01,0x02,0x04,
+    0x01,0x01,0x01,0x08,0x01,0x01,0x01,0x0B,0x01,0x01,0x02,0x03,0x02,0x07,0x01,0x01,0x03,0x03,0x01,0x05,0x03,0x03,0x01,0x09,
+    0x03,0x03,0x01,0x01,0x04,0x0B,0x01,0x03,0x05,0x07,0x01,0x03,0x06,0x01,0x01,0x09,0x06,0x01,0x01,0x02,0x07,0x01,0x01,0x0A,
+    0x07,0x01,0x01
+};
+
+//monster_sprite_3A opaque: 14 spans, 248 of 416 pixels = 67B
+static const uint8_t monster_sprite_3A_spans[67] PROGMEM = {
+    0x0E,0x0D,0x08,0x02,0x02,0x00,0x00,0x0C,0x08,0xF8,0x00,0x04,0x00,0x04,0x01,0x01,0x01,0x0A,0x01,0x00,0x02,0x0C,0x01,0x00,
+    0x03,0x03,0x01,0x05,0x03,0x02,0x01,0x09,0x03,0x03,0x01,0x00,0x04,0x0C,0x01,0x02,0x05,0x03,0x01,0x07,0x05,0x03,0x01,0x01,
+    0x06,0x02,0x01,0x05,0x06,0x02,0x01,0x09,0x06,0x02,0x01,0x02,0x07,0x02,0x01,0x08,0x07,0x02,0x01
+};
+
+//monster_sprite_3B opaque: 14 spans, 240 of 416 pixels = 67B
+static const uint8_t monster_sprite_3B_spans[67] PROGMEM = {
+    0x0E,0x0D,0x08,0x02,0x02,0x00,0x00,0x0C,0x08,0xF0,0x00,0x04,0x00,0x04,0x01,0x01,0x01,0x0A,0x01,0x00,0x02,0x0C,0x01,0x00,
+    0x03,0x03,0x01,0x05,0x03,0x02,0x01,0x09,0x03,0x03,0x01,0x00,0x04,0x0C,0x01,0x03,0x05,0x02,0x01,0x07,0x05,0x02,0x01,0x02,
+    0x06,0x02,0x01,0x05,0x06,0x02,0x01,0x08,0x06,0x02,0x01,0x00,0x07,0x02,0x01,0x0A,0x07,0x02,0x01
+};
+
+//Total 2547B (raw 3662B)
+#endif /* SPRITES_H */
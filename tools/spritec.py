@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+"""
+  spritec.py
+  Sprite converter for the Space Invaders clone.
+  Reads the raw RGB565 art in image.h and writes sprites.h, with every
+  sprite stored in the format chosen in the SPRITES table below.
+
+  Usage: python3 tools/spritec.py image.h lcd/svgrgb565.h > sprites.h
+     or: make sprites
+
+  Formats:
+    raw  one RGB565 word per pixel (as in image.h), drawn with
+         fill_image_pgm / fill_image_pgm_2b.
+    rle  runs of identical pixels, three bytes each: the run length
+         (1-255) followed by the colour, low byte first. Runs carry on
+         across rows. Drawn with fill_image_pgm_rle / fill_image_pgm_rle_2b.
+    idx  palette indexed, 1, 2 or 4 bits per pixel depending on the number
+         of colours. The first byte holds the bits per pixel, then every
+         row starts on a new byte with the leftmost pixel in the most
+         significant bits. The palette (name_pal) is a separate array of
+         RGB565 words, so the same pixels can be drawn with other
+         palettes; the background colour, if present, is index 0.
+         Drawn with fill_image_pgm_indexed / fill_image_pgm_indexed_2b.
+         Use 'idx-nopal' when the game provides its own palettes.
+
+  Scale: sprites are stored at their native resolution and drawn with
+  every pixel repeated xs times across and ys times down (the _scaled
+  blitters, _2b is 2x1).
+
+  Span tables: rectangles of a sprite to send, each one in its own
+  window. Header: span count, width and height of the sprite, scale xs
+  and ys, bounding box x, y, w, h of the spans, pixel count on screen
+  (16 bit, low byte first); then x, y, w, h of every span. Everything
+  but the pixel count is in stored pixels, x and y are signed and
+  relative to the sprite. Pixels are taken from the indexed image of
+  the sprite, index 0 outside it. Drawn with fill_image_pgm_spans, or
+  in a single colour with fill_spans.
+    Deltas (DELTAS table): the spans to repaint when a sprite on screen
+    is replaced by another one drawn (dx, dy) screen pixels away, e.g.
+    the next animation frame one formation step further.
+    Opaque spans (SPANS table, name_spans): the pixels of a sprite that
+    are not background, so that it is drawn with a transparent
+    background, or erased without touching what is around it.
+
+  Author: Giacomo Meanti
+"""
+
+import re
+import sys
+
+# name, width of the stored image, format, scale (xs, ys)
+SPRITES = [
+    ('cannon_sprite',      27, 'rle',       (1, 1)),
+    ('cannon_sprite_2',    27, 'idx',       (1, 1)),
+    ('cannon_sprite_3',    27, 'idx',       (1, 1)),
+    ('heart_sprite',        9, 'idx',       (1, 1)),
+    ('astro_sprite',       16, 'idx',       (2, 2)),
+    ('monster_sprite_1A',  13, 'idx-nopal', (2, 2)),
+    ('monster_sprite_1B',  13, 'idx-nopal', (2, 2)),
+    ('monster_sprite_2A',  13, 'idx-nopal', (2, 2)),
+    ('monster_sprite_2B',  13, 'idx-nopal', (2, 2)),
+    ('monster_sprite_3A',  13, 'idx-nopal', (2, 2)),
+    ('monster_sprite_3B',  13, 'idx-nopal', (2, 2)),
+    ('monster_sprite_exp', 13, 'idx',       (2, 2)),
+    ('triangle_sprite',     4, 'idx',       (1, 1)),
+]
+
+# name, sprite on screen, sprite replacing it, move (screen pixels)
+DELTAS = [('monster_delta_%s%s%s_%s' % (k, a, b, move),
+           'monster_sprite_%s%s' % (k, a), 'monster_sprite_%s%s' % (k, b), dx, dy)
+          for k in '123'
+          for a, b in (('A', 'B'), ('B', 'A'))
+          for move, dx, dy in (('r', 8, 0), ('l', -8, 0), ('rd', 8, 8), ('ld', -8, 8))]
+
+# sprites that get an opaque span table
+SPANS = ['astro_sprite', 'monster_sprite_exp'] + \
+        ['monster_sprite_%s%s' % (k, a) for k in '123' for a in 'AB']
+
+# Unchanged pixels between two changed ones are resent up to this gap,
+# opening another window costs more.
+DELTA_GAP = 2
+
+BACKGROUND = 0x0000
+
+
+def read_colours(path):
+    colours = {}
+    for m in re.finditer(r'#define\s+(\w+)\s+(0x[0-9A-Fa-f]+)', open(path).read()):
+        colours[m.group(1)] = int(m.group(2), 16)
+    return colours
+
+
+def read_images(path, colours):
+    images = {}
+    src = open(path).read()
+    for m in re.finditer(r'(\w+)\[\d*\]\s+PROGMEM\s*=\s*\{(.*?)\};', src, re.S):
+        body = re.sub(r'//.*', '', m.group(2))
+        pixels = []
+        for tok in body.replace('\n', ',').split(','):
+            tok = tok.strip()
+            if tok:
+                pixels.append(colours[tok] if tok in colours else int(tok, 0))
+        images[m.group(1)] = pixels
+    return images
+
+
+def encode_rle(pixels):
+    runs = []
+    for p in pixels:
+        if runs and runs[-1][1] == p and runs[-1][0] < 255:
+            runs[-1][0] += 1
+        else:
+            runs.append([1, p])
+    out = []
+    for n, col in runs:
+        out += [n, col & 0xFF, col >> 8]
+    return out
+
+
+def make_palette(pixels):
+    palette = [BACKGROUND] if BACKGROUND in pixels else []
+    for p in pixels:
+        if p not in palette:
+            palette.append(p)
+    return palette
+
+
+def encode_indexed(pixels, width, palette):
+    bpp = 1
+    while (1 << bpp) < len(palette):
+        bpp <<= 1
+    if bpp > 4:
+        sys.exit('%d colours do not fit in 4 bits per pixel' % len(palette))
+    out = [bpp]
+    for row in range(0, len(pixels), width):
+        byte = nbits = 0
+        for p in pixels[row:row + width]:
+            byte = (byte << bpp) | palette.index(p)
+            nbits += bpp
+            if nbits == 8:
+                out.append(byte)
+                byte = nbits = 0
+        if nbits:
+            out.append(byte << (8 - nbits))
+    return bpp, out
+
+
+def encode_delta(before, after, width, height, scale, dx, dy, gap=DELTA_GAP):
+    def opaque(pixels, x, y):
+        return 0 <= x < width and 0 <= y < height and pixels[y * width + x] != BACKGROUND
+
+    # runs of changed pixels on each row, relative to the new position
+    rows = {}
+    for y in range(min(0, -dy), height + max(0, -dy)):
+        xs = [x for x in range(min(0, -dx), width + max(0, -dx))
+              if opaque(before, x + dx, y + dy) != opaque(after, x, y)
+              or (opaque(after, x, y) and before[(y + dy) * width + x + dx]
+                  != after[y * width + x])]
+        runs = []
+        for x in xs:
+            if runs and x - runs[-1][1] - 1 <= gap:
+                runs[-1][1] = x
+            else:
+                runs.append([x, x])
+        rows[y] = runs
+    # stack identical runs of consecutive rows
+    spans = []
+    for y in sorted(rows):
+        for x0, x1 in rows[y]:
+            for s in spans:
+                if s[0] == x0 and s[2] == x1 - x0 + 1 and s[1] + s[3] == y:
+                    s[3] += 1
+                    break
+            else:
+                spans.append([x0, y, x1 - x0 + 1, 1])
+    spans.sort(key=lambda s: (s[1], s[0]))
+    if spans:
+        left = min(s[0] for s in spans)
+        top = min(s[1] for s in spans)
+        box = [left, top, max(s[0] + s[2] for s in spans) - left,
+               max(s[1] + s[3] for s in spans) - top]
+    else:
+        box = [0, 0, 0, 0]
+    pixels = sum(s[2] * s[3] for s in spans) * scale[0] * scale[1]
+    out = [len(spans), width, height] + list(scale) + box + [pixels & 0xFF, pixels >> 8]
+    for s in spans:
+        out += s
+    return pixels, [v & 0xFF for v in out]
+
+
+def emit_array(ctype, name, values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ','.join(fmt % v for v in values[i:i + per_line]))
+    return 'static %s %s[%d] PROGMEM = {\n%s\n};\n' % (
+        ctype, name, len(values), ',\n'.join(lines))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit('usage: spritec.py image.h svgrgb565.h')
+    colours = read_colours(sys.argv[2])
+    images = read_images(sys.argv[1], colours)
+    out = ['/*',
+           '  sprites.h',
+           '  Generated by tools/spritec.py from image.h, do not edit.',
+           '  See image.h for the source art and spritec.py for the formats.',
+           '*/',
+           '',
+           '#ifndef SPRITES_H',
+           '#define SPRITES_H',
+           '#include <avr/pgmspace.h>',
+           '#include <stdint.h>',
+           '']
+    total = raw_total = 0
+    for name, width, fmt, scale in SPRITES:
+        pixels = images[name]
+        if len(pixels) % width:
+            sys.exit('%s: %d pixels is not a multiple of width %d'
+                     % (name, len(pixels), width))
+        height = len(pixels) // width
+        raw_size = len(pixels) * 2
+        dims = '%dx%d' % (width, height)
+        if scale != (1, 1):
+            dims += ' drawn %dx%d' % scale
+        if fmt == 'raw':
+            size = raw_size
+            out.append('//%s, raw = %dB' % (dims, size))
+            out.append(emit_array('uint16_t', name, pixels, width, '0x%04X'))
+        elif fmt == 'rle':
+            data = encode_rle(pixels)
+            size = len(data)
+            out.append('//%s, RLE %d runs = %dB (raw %dB)'
+                       % (dims, size // 3, size, raw_size))
+            out.append(emit_array('const uint8_t', name + '_rle', data, 24, '0x%02X'))
+        elif fmt in ('idx', 'idx-nopal'):
+            palette = make_palette(pixels)
+            bpp, data = encode_indexed(pixels, width, palette)
+            size = len(data)
+            if fmt == 'idx':
+                size += 2 * len(palette)
+            out.append('//%s, %dbpp indexed = %dB, %d colours (raw %dB)'
+                       % (dims, bpp, size, len(palette), raw_size))
+            if fmt == 'idx':
+                out.append(emit_array('const uint16_t', name + '_pal', palette, 16, '0x%04X'))
+            out.append(emit_array('const uint8_t', name + '_idx', data, 24, '0x%02X'))
+        else:
+            sys.exit('%s: unknown format %s' % (name, fmt))
+        total += size
+        raw_total += raw_size
+    widths = dict((name, width) for name, width, fmt, scale in SPRITES)
+    scales = dict((name, scale) for name, width, fmt, scale in SPRITES)
+    for name, before, after, dx, dy in DELTAS:
+        width = widths[after]
+        height = len(images[after]) // width
+        scale = scales[after]
+        if widths[before] != width or len(images[before]) != len(images[after]) \
+                or scales[before] != scale:
+            sys.exit('%s: %s and %s differ in size' % (name, before, after))
+        if dx % scale[0] or dy % scale[1]:
+            sys.exit('%s: move %d,%d is not a whole number of pixels' % (name, dx, dy))
+        pixels, data = encode_delta(images[before], images[after], width, height, scale,
+                                    dx // scale[0], dy // scale[1])
+        out.append('//%s -> %s moved %d,%d: %d spans, %d pixels = %dB'
+                   % (before, after, dx, dy, data[0], pixels, len(data)))
+        out.append(emit_array('const uint8_t', name, data, 24, '0x%02X'))
+        total += len(data)
+    for name in SPANS:
+        width = widths[name]
+        height = len(images[name]) // width
+        # a delta from nothing, never resending a background pixel
+        scale = scales[name]
+        pixels, data = encode_delta([BACKGROUND] * len(images[name]), images[name],
+                                    width, height, scale, 0, 0, 0)
+        out.append('//%s opaque: %d spans, %d of %d pixels = %dB'
+                   % (name, data[0], pixels, width * height * scale[0] * scale[1], len(data)))
+        out.append(emit_array('const uint8_t', name + '_spans', data, 24, '0x%02X'))
+        total += len(data)
+    out.append('//Total %dB (raw %dB)' % (total, raw_total))
+    out.append('#endif /* SPRITES_H */')
+    sys.stdout.write('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()